@@ -0,0 +1,118 @@
+#include "BatchResampler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+
+#include "ClipSampler.h"
+
+// The state shared by the segments of a clip being resampled. The last segment to finish calls onDone.
+struct ResampleTask {
+
+    Clip input;
+    Clip output;
+    ClipSampler sampler;
+    std::atomic<int> remainingSegments;
+    std::function<void(ResampleTask&)> onDone;
+
+    ResampleTask() : sampler(&input), remainingSegments(0) {}
+
+};
+
+static void finishSegment(const std::shared_ptr<ResampleTask>& task) {
+    if(--task->remainingSegments == 0) {
+        task->onDone(*task);
+    }
+}
+
+// To be run on the pool once the input clip is loaded: the segments after the first one are queued on the current
+// worker, where idle workers can steal them
+static void runResampleTask(ThreadPool& pool, const std::shared_ptr<ResampleTask>& task, float rate) {
+
+    task->sampler.update();
+    int numFrames = task->sampler.getNumResampledFrames(rate);
+    task->output.resize(numFrames, task->input.hasOrientations());
+    if(task->input.hasFloorPlane()) {
+        task->output.setFloorPlane(task->input.getFloorPlane());
+    }
+
+    int numSegments = std::max(1, (numFrames + RESAMPLE_SEGMENT_FRAMES - 1) / RESAMPLE_SEGMENT_FRAMES);
+    task->remainingSegments = numSegments;
+
+    for(int segment = 1; segment < numSegments; segment++) {
+        pool.submit([task, rate, segment, numFrames] {
+            int first = segment * RESAMPLE_SEGMENT_FRAMES;
+            task->sampler.resampleInto(rate, first, std::min(first + RESAMPLE_SEGMENT_FRAMES, numFrames),
+                                       task->output);
+            finishSegment(task);
+        });
+    }
+
+    task->sampler.resampleInto(rate, 0, std::min(RESAMPLE_SEGMENT_FRAMES, numFrames), task->output);
+    finishSegment(task);
+
+}
+
+std::string getBaseName(const std::string& fileName) {
+    size_t separator = fileName.find_last_of("/\\");
+    return separator == std::string::npos ? fileName : fileName.substr(separator + 1);
+}
+
+BatchStatistics resampleRecordings(const std::vector<std::string>& fileNames, const std::string& outputDirectory,
+                                   float rate, ThreadPool& pool) {
+
+    std::atomic<int> numClips(0);
+    std::atomic<long> numFrames(0);
+    auto start = std::chrono::steady_clock::now();
+
+    for(const std::string& fileName : fileNames) {
+        std::string outputName = outputDirectory + "/" + getBaseName(fileName);
+        pool.submit([&pool, &numClips, &numFrames, fileName, outputName, rate] {
+            auto task = std::make_shared<ResampleTask>();
+            task->input = getJointClip(fileName);
+            // a missing or unreadable file loads as an empty clip: it is reported and skipped, not written
+            if(task->input.getNumFrames() == 0) {
+                std::cout << "ERROR::RESAMPLE::EMPTY_RECORDING " << fileName << std::endl;
+                return;
+            }
+            task->onDone = [&numClips, &numFrames, outputName](ResampleTask& done) {
+                writeJointClip(outputName, done.output);
+                numClips++;
+                numFrames += done.output.getNumFrames();
+            };
+            runResampleTask(pool, task, rate);
+        });
+    }
+    pool.wait();
+
+    return {numClips.load(), numFrames.load(),
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+
+}
+
+BatchStatistics resampleClips(const std::vector<Clip>& clips, std::vector<Clip>& results, float rate, ThreadPool& pool) {
+
+    std::atomic<long> numFrames(0);
+    results.resize(clips.size());
+    auto start = std::chrono::steady_clock::now();
+
+    for(size_t i = 0; i < clips.size(); i++) {
+        pool.submit([&pool, &numFrames, &clips, &results, i, rate] {
+            auto task = std::make_shared<ResampleTask>();
+            task->input = clips[i];
+            task->onDone = [&numFrames, &results, i](ResampleTask& done) {
+                numFrames += done.output.getNumFrames();
+                results[i] = std::move(done.output);
+            };
+            runResampleTask(pool, task, rate);
+        });
+    }
+    pool.wait();
+
+    return {(int)clips.size(), numFrames.load(),
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+
+}
@@ -0,0 +1,31 @@
+#ifndef INC_3D_AVATAR_BATCHRESAMPLER_H
+#define INC_3D_AVATAR_BATCHRESAMPLER_H
+
+#include <string>
+#include <vector>
+
+#include "Clip.h"
+#include "ThreadPool.h"
+
+// Clips longer than this are resampled in segments of this many output frames, spread across the pool
+const int RESAMPLE_SEGMENT_FRAMES = 4096;
+
+struct BatchStatistics {
+    int numClips;
+    long numFrames;         // output frames
+    double seconds;
+};
+
+// The file name of a path without its directories, under which a batch writes each result in its output directory
+std::string getBaseName(const std::string& fileName);
+
+// Resamples every recording to rate frames per second on the pool, writing each result in outputDirectory under the
+// same file name. Recordings that are missing or have no frames are reported and left out of the statistics.
+BatchStatistics resampleRecordings(const std::vector<std::string>& fileNames, const std::string& outputDirectory,
+                                   float rate, ThreadPool& pool);
+
+// Same as resampleRecordings(), on clips already in memory
+BatchStatistics resampleClips(const std::vector<Clip>& clips, std::vector<Clip>& results, float rate, ThreadPool& pool);
+
+
+#endif //INC_3D_AVATAR_BATCHRESAMPLER_H
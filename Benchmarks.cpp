@@ -0,0 +1,587 @@
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "BatchResampler.h"
+#include "BlendEngine.h"
+#include "BoneLengthSolver.h"
+#include "FloorPlane.h"
+#include "HoltSmoother.h"
+#include "KalmanFilterBank.h"
+#include "KeyframeReducer.h"
+#include "ClipSampler.h"
+#include "OneEuroFilter.h"
+#include "Orientation.h"
+#include "OutlierRejector.h"
+#include "Skeleton.h"
+
+typedef std::chrono::steady_clock benchmarkClock;
+
+static double secondsSince(benchmarkClock::time_point start) {
+    return std::chrono::duration<double>(benchmarkClock::now() - start).count();
+}
+
+void benchmarkSampler(const Clip& clip) {
+
+    const int numPoses = 1000000;
+    float pose[NUM_CHANNELS];
+    float checksum = 0.0f;
+
+    for(SampleMode mode : {SAMPLE_LINEAR, SAMPLE_CATMULL_ROM}) {
+
+        ClipSampler sampler(&clip, mode);
+        float step = clip.getDuration() / numPoses;
+
+        benchmarkClock::time_point start = benchmarkClock::now();
+        for(int i = 0; i < numPoses; i++) {
+            sampler.sample(i * step, pose);
+            checksum += pose[i % NUM_CHANNELS];
+        }
+        double elapsed = secondsSince(start);
+
+        std::cout << (mode == SAMPLE_LINEAR ? "linear" : "catmull-rom") << " sampling: "
+                  << numPoses / elapsed << " poses per second" << std::endl;
+
+    }
+
+    // printing the checksum keeps the compiler from optimizing the loops away
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+
+}
+
+// Fills quaternions with random unit rotations
+static void randomOrientations(std::mt19937& generator, float* quaternions, int count) {
+
+    std::normal_distribution<float> normal;
+    for(int i = 0; i < count; i++) {
+        float length = 0.0f;
+        for(int j = 0; j < 4; j++) {
+            quaternions[4 * i + j] = normal(generator);
+            length += quaternions[4 * i + j] * quaternions[4 * i + j];
+        }
+        for(int j = 0; j < 4; j++) {
+            quaternions[4 * i + j] /= std::sqrt(length);
+        }
+    }
+
+}
+
+void benchmarkOrientations() {
+
+    const int numFrames = 1000;
+    const int numRepetitions = 200;
+    std::mt19937 generator(42);
+    std::vector<float> from(numFrames * NUM_ORIENTATION_CHANNELS);
+    std::vector<float> to(numFrames * NUM_ORIENTATION_CHANNELS);
+    float batched[NUM_ORIENTATION_CHANNELS];
+    float exact[4];
+
+    // half of the pairs are close (where nlerp is used), the other half are arbitrary rotations (where slerp is)
+    randomOrientations(generator, from.data(), numFrames * NUM_JOINTS);
+    randomOrientations(generator, to.data(), numFrames * NUM_JOINTS);
+    for(int i = 0; i < (int)from.size() / 2; i++) {
+        to[i] = from[i] + 0.1f * to[i];
+    }
+    for(int i = 0; i < numFrames * NUM_JOINTS / 2; i++) {
+        float length = std::sqrt(to[4 * i] * to[4 * i] + to[4 * i + 1] * to[4 * i + 1] +
+                                 to[4 * i + 2] * to[4 * i + 2] + to[4 * i + 3] * to[4 * i + 3]);
+        for(int j = 0; j < 4; j++) {
+            to[4 * i + j] /= length;
+        }
+    }
+
+    // accuracy: largest rotation angle between the batched result and the exact slerp
+    double maxError = 0.0;
+    for(int i = 0; i < numFrames; i++) {
+        float u = (i % 11) / 10.0f;
+        interpolateOrientations(&from[i * NUM_ORIENTATION_CHANNELS], &to[i * NUM_ORIENTATION_CHANNELS], u, batched);
+        for(int j = 0; j < NUM_JOINTS; j++) {
+            slerpOrientation(&from[i * NUM_ORIENTATION_CHANNELS + 4 * j], &to[i * NUM_ORIENTATION_CHANNELS + 4 * j],
+                             u, exact);
+            double dot = std::fabs(batched[4 * j] * exact[0] + batched[4 * j + 1] * exact[1] +
+                                   batched[4 * j + 2] * exact[2] + batched[4 * j + 3] * exact[3]);
+            maxError = std::max(maxError, 2 * std::acos(std::min(dot, 1.0)) * 180 / 3.141592653);
+        }
+    }
+    std::cout << "orientation interpolation: max error against slerp " << maxError << " degrees" << std::endl;
+
+    float checksum = 0.0f;
+    benchmarkClock::time_point start = benchmarkClock::now();
+    for(int r = 0; r < numRepetitions; r++) {
+        for(int i = 0; i < numFrames; i++) {
+            interpolateOrientations(&from[i * NUM_ORIENTATION_CHANNELS], &to[i * NUM_ORIENTATION_CHANNELS], 0.3f,
+                                    batched);
+            checksum += batched[i % NUM_ORIENTATION_CHANNELS];
+        }
+    }
+    double elapsed = secondsSince(start);
+    std::cout << "orientation interpolation: " << numRepetitions * numFrames / elapsed << " frames ("
+              << NUM_JOINTS << " joints each) per second (checksum " << checksum << ")" << std::endl;
+
+    checksum = 0.0f;
+    start = benchmarkClock::now();
+    for(int r = 0; r < numRepetitions; r++) {
+        for(int i = 0; i < numFrames; i++) {
+            for(int j = 0; j < NUM_JOINTS; j++) {
+                slerpOrientation(&from[i * NUM_ORIENTATION_CHANNELS + 4 * j],
+                                 &to[i * NUM_ORIENTATION_CHANNELS + 4 * j], 0.3f, &batched[4 * j]);
+            }
+            checksum += batched[i % NUM_ORIENTATION_CHANNELS];
+        }
+    }
+    elapsed = secondsSince(start);
+    std::cout << "scalar slerp: " << numRepetitions * numFrames / elapsed << " frames per second (checksum "
+              << checksum << ")" << std::endl;
+
+}
+
+void benchmarkBatchResampling(const Clip& clip) {
+
+    const int numClips = 64;
+    const int numLongClips = 8;
+    const int longClipRepetitions = 40;
+    const float rate = 120.0f;
+
+    // the long clips play the recording over and over
+    Clip longClip;
+    for(int r = 0; r < longClipRepetitions; r++) {
+        for(int i = 0; i < clip.getNumFrames(); i++) {
+            longClip.addFrame(clip.getFrame(i), r * (clip.getDuration() + 1 / DEFAULT_KEY_RATE) + clip.getTime(i));
+        }
+    }
+    std::vector<Clip> library(numClips, clip);
+    for(int i = 0; i < numLongClips; i++) {
+        library[i * numClips / numLongClips] = longClip;
+    }
+
+    int maxThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    double singleThreadRate = 0.0;
+    std::vector<Clip> results;
+    for(int numThreads = 1; ; numThreads = std::min(2 * numThreads, maxThreads)) {
+
+        ThreadPool pool(numThreads);
+        BatchStatistics statistics = resampleClips(library, results, rate, pool);
+        double framesPerSecond = statistics.numFrames / statistics.seconds;
+        if(numThreads == 1) {
+            singleThreadRate = framesPerSecond;
+        }
+
+        std::cout << "batch resampling, " << numThreads << " threads: " << statistics.numClips << " clips, "
+                  << statistics.numFrames << " frames in " << statistics.seconds << " s, " << framesPerSecond
+                  << " frames per second (x" << framesPerSecond / singleThreadRate << ")" << std::endl;
+
+        if(numThreads == maxThreads) {
+            break;
+        }
+
+    }
+
+}
+
+void benchmarkSeek(const Clip& clip) {
+
+    const int repetitions = 1000;
+    const int numSeeks = 1000000;
+
+    Clip longClip;
+    for(int r = 0; r < repetitions; r++) {
+        for(int i = 0; i < clip.getNumFrames(); i++) {
+            longClip.addFrame(clip.getFrame(i), r * (clip.getDuration() + 1 / DEFAULT_KEY_RATE) + clip.getTime(i));
+        }
+    }
+    ClipSampler sampler(&longClip);
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> times(0.0f, longClip.getDuration());
+    std::vector<float> seeks(numSeeks);
+    for(float& t : seeks) {
+        t = times(generator);
+    }
+
+    float pose[NUM_CHANNELS];
+    float checksum = 0.0f;
+    benchmarkClock::time_point start = benchmarkClock::now();
+    for(int i = 0; i < numSeeks; i++) {
+        sampler.sample(seeks[i], pose);
+        checksum += pose[i % NUM_CHANNELS];
+    }
+    double elapsed = secondsSince(start);
+
+    std::cout << "random seek on " << longClip.getNumFrames() << " keys (" << longClip.getDuration() / 60
+              << " minutes): " << elapsed / numSeeks * 1e9 << " ns per seek (checksum " << checksum << ")"
+              << std::endl;
+
+}
+
+void benchmarkBlend(const Clip& clip) {
+
+    const int numFrames = 100000;
+    const int numLayers = 4;
+    const double frameTime = 1 / 60.0;
+
+    ClipSampler sampler(&clip);
+    float lowerBody[NUM_JOINTS];
+    float upperBody[NUM_JOINTS];
+    fillBodyMask(lowerBody, true);
+    fillBodyMask(upperBody, false);
+
+    BlendEngine engine;
+    for(int i = 0; i < numLayers; i++) {
+        engine.addLayer(&sampler, 1.0f, i % 2 == 0 ? lowerBody : upperBody);
+        engine.getPlayback(i).seek(i * clip.getDuration() / numLayers);
+    }
+
+    float pose[NUM_CHANNELS] = {};
+    float checksum = 0.0f;
+    benchmarkClock::time_point start = benchmarkClock::now();
+    for(int i = 0; i < numFrames; i++) {
+        engine.update(frameTime);
+        engine.evaluate(pose);
+        checksum += pose[i % NUM_CHANNELS];
+    }
+    double perFrame = secondsSince(start) / numFrames;
+
+    // the blend alone, on poses already sampled
+    std::vector<BlendSource> sources;
+    for(int i = 0; i < numLayers; i++) {
+        sources.push_back({clip.getFrame(i), 0.25f, i % 2 == 0 ? lowerBody : upperBody});
+    }
+    start = benchmarkClock::now();
+    for(int i = 0; i < numFrames; i++) {
+        blendPoses(sources.data(), numLayers, pose);
+        checksum += pose[i % NUM_CHANNELS];
+    }
+    double blendPerFrame = secondsSince(start) / numFrames;
+
+    std::cout << "blending " << numLayers << " layers: " << perFrame * 1e6 << " us per frame with sampling ("
+              << perFrame / frameTime * 100 << "% of a 60 Hz frame), " << blendPerFrame * 1e6
+              << " us for the blend alone (checksum " << checksum << ")" << std::endl;
+
+}
+
+// Mean distance between a frame and the average of its neighbours, over all the joints of the clip
+static float getJitter(const std::vector<float>& positions, int numFrames) {
+
+    double jitter = 0.0;
+    for(int i = 1; i < numFrames - 1; i++) {
+        for(int j = 0; j < NUM_JOINTS; j++) {
+            float distance2 = 0.0f;
+            for(int c = 3 * j; c < 3 * j + 3; c++) {
+                float d = positions[i * NUM_CHANNELS + c] -
+                          (positions[(i - 1) * NUM_CHANNELS + c] + positions[(i + 1) * NUM_CHANNELS + c]) / 2;
+                distance2 += d * d;
+            }
+            jitter += std::sqrt(distance2);
+        }
+    }
+    return (float)(jitter / ((numFrames - 2) * NUM_JOINTS));
+
+}
+
+void benchmarkOneEuro(const Clip& clip) {
+
+    const int numFrames = 1000000;
+    const double frameTime = 1 / 30.0;
+    float checksum = 0.0f;
+
+    OneEuroFilter filter;
+    std::vector<float> frame(NUM_CHANNELS);
+    benchmarkClock::time_point start = benchmarkClock::now();
+    for(int i = 0; i < numFrames; i++) {
+        const float* key = clip.getFrame(i % clip.getNumFrames());
+        std::copy(key, key + NUM_CHANNELS, frame.begin());
+        filter.filter(frame.data(), i * frameTime);
+        checksum += frame[i % NUM_CHANNELS];
+    }
+    double elapsed = secondsSince(start);
+    std::cout << "one euro filter: " << elapsed / numFrames * 1e9 << " ns per frame (checksum " << checksum << ")"
+              << std::endl;
+
+    // lag behind a joint moving at constant speed, once the filter has settled
+    for(float metresPerSecond : {0.1f, 0.5f, 2.0f}) {
+        float speed = CLIP_SCALE * metresPerSecond;
+        filter.reset();
+        for(int i = 0; i < 90; i++) {
+            std::fill(frame.begin(), frame.end(), speed * (float)(i * frameTime));
+            filter.filter(frame.data(), i * frameTime);
+        }
+        float target = speed * (float)(89 * frameTime);
+        std::cout << "one euro lag at " << metresPerSecond << " m/s: torso "
+                  << (target - frame[3 * SPINE_MID]) / speed * 1000 << " ms, hands "
+                  << (target - frame[3 * HAND_LEFT]) / speed * 1000 << " ms" << std::endl;
+    }
+
+    int numKeys = clip.getNumFrames();
+    std::vector<float> raw(clip.getFrame(0), clip.getFrame(0) + numKeys * NUM_CHANNELS);
+    std::vector<float> filtered(raw);
+    filter.reset();
+    for(int i = 0; i < numKeys; i++) {
+        filter.filter(filtered.data() + i * NUM_CHANNELS, clip.getTime(i));
+    }
+    std::cout << "one euro jitter on the clip: " << getJitter(raw, numKeys) / CLIP_SCALE * 1000 << " mm raw, "
+              << getJitter(filtered, numKeys) / CLIP_SCALE * 1000 << " mm filtered" << std::endl;
+
+}
+
+void benchmarkHolt(const Clip& clip) {
+
+    const int repetitions = 10000;
+    int numKeys = clip.getNumFrames();
+    std::vector<float> raw(clip.getFrame(0), clip.getFrame(0) + numKeys * NUM_CHANNELS);
+    std::vector<float> smoothed(raw.size());
+    const HoltSettings presets[] = {HOLT_SMOOTH, HOLT_VERY_SMOOTH};
+    const char* presetNames[] = {"smooth", "very smooth"};
+
+    for(int p = 0; p < 2; p++) {
+
+        HoltSmoother smoother(presets[p]);
+        float checksum = 0.0f;
+        double elapsed = 0.0;
+        for(int r = 0; r < repetitions; r++) {
+            std::copy(raw.begin(), raw.end(), smoothed.begin());
+            smoother.reset();
+            benchmarkClock::time_point start = benchmarkClock::now();
+            smoother.smooth(smoothed.data(), clip.getTrackingStates(0), numKeys);
+            elapsed += secondsSince(start);
+            checksum += smoothed[r % smoothed.size()];
+        }
+
+        std::cout << "holt smoothing (" << presetNames[p] << "): "
+                  << elapsed / ((double)repetitions * numKeys) * 1e9 << " ns per frame, jitter "
+                  << getJitter(raw, numKeys) / CLIP_SCALE * 1000 << " mm raw, "
+                  << getJitter(smoothed, numKeys) / CLIP_SCALE * 1000 << " mm smoothed (checksum " << checksum << ")"
+                  << std::endl;
+
+    }
+
+}
+
+void benchmarkKalman(const Clip& clip) {
+
+    const int numBodies = 6;
+    const int numFrames = 100000;
+    const double frameTime = 1 / 30.0;
+
+    std::vector<KalmanFilterBank> banks(numBodies);
+    float checksum = 0.0f;
+    benchmarkClock::time_point start = benchmarkClock::now();
+    for(int i = 0; i < numFrames; i++) {
+        for(int b = 0; b < numBodies; b++) {
+            int key = (i + 17 * b) % clip.getNumFrames();
+            banks[b].update(clip.getFrame(key), clip.getTrackingStates(key), i * frameTime);
+            checksum += banks[b].getVelocities()[i % NUM_CHANNELS];
+        }
+    }
+    double elapsed = secondsSince(start);
+    std::cout << "kalman filter bank: " << elapsed / numFrames * 1e6 << " us per frame for " << numBodies
+              << " bodies (checksum " << checksum << ")" << std::endl;
+
+    // velocity estimate of a joint moving at 1 m/s, after a second
+    KalmanFilterBank bank;
+    float frame[NUM_CHANNELS];
+    unsigned char states[NUM_JOINTS];
+    std::fill(states, states + NUM_JOINTS, (unsigned char)TRACKED);
+    for(int i = 0; i < 30; i++) {
+        std::fill(frame, frame + NUM_CHANNELS, CLIP_SCALE * (float)(i * frameTime));
+        bank.update(frame, states, i * frameTime);
+    }
+    std::cout << "kalman velocity at 1 m/s: " << bank.getVelocities()[0] / CLIP_SCALE << " m/s" << std::endl;
+
+}
+
+// Mean over the bones of the standard deviation of their length along the clip
+static float getBoneLengthDeviation(const std::vector<float>& positions, int numFrames) {
+
+    double deviation = 0.0;
+    for(int j = 0; j < NUM_JOINTS; j++) {
+        int parent = JOINT_PARENTS[j];
+        if(parent < 0) {
+            continue;
+        }
+        double sum = 0.0;
+        double sum2 = 0.0;
+        for(int i = 0; i < numFrames; i++) {
+            const float* p = positions.data() + i * NUM_CHANNELS;
+            double length = std::sqrt(std::pow(p[3 * j] - p[3 * parent], 2) +
+                                      std::pow(p[3 * j + 1] - p[3 * parent + 1], 2) +
+                                      std::pow(p[3 * j + 2] - p[3 * parent + 2], 2));
+            sum += length;
+            sum2 += length * length;
+        }
+        double mean = sum / numFrames;
+        deviation += std::sqrt(std::max(0.0, sum2 / numFrames - mean * mean));
+    }
+    return (float)(deviation / (NUM_JOINTS - 1));
+
+}
+
+void benchmarkBoneLengths(const Clip& clip) {
+
+    const int numFrames = 1000000;
+    BoneLengthSolver solver;
+    solver.calibrate(clip);
+
+    float frame[NUM_CHANNELS];
+    float checksum = 0.0f;
+    benchmarkClock::time_point start = benchmarkClock::now();
+    for(int i = 0; i < numFrames; i++) {
+        const float* key = clip.getFrame(i % clip.getNumFrames());
+        std::copy(key, key + NUM_CHANNELS, frame);
+        solver.solve(frame);
+        checksum += frame[i % NUM_CHANNELS];
+    }
+    double elapsed = secondsSince(start);
+
+    int numKeys = clip.getNumFrames();
+    std::vector<float> raw(clip.getFrame(0), clip.getFrame(0) + numKeys * NUM_CHANNELS);
+    std::vector<float> solved(raw);
+    for(int i = 0; i < numKeys; i++) {
+        solver.solve(solved.data() + i * NUM_CHANNELS);
+    }
+
+    std::cout << "bone length solver: " << elapsed / numFrames * 1e9 << " ns per body, bone length deviation "
+              << getBoneLengthDeviation(raw, numKeys) / CLIP_SCALE * 1000 << " mm raw, "
+              << getBoneLengthDeviation(solved, numKeys) / CLIP_SCALE * 1000 << " mm solved (checksum " << checksum
+              << ")" << std::endl;
+
+}
+
+void benchmarkOutliers(const Clip& clip) {
+
+    const int numFrames = 1000000;
+    const double frameTime = 1 / 30.0;
+
+    // the clip resampled at the sensor rate, with a joint thrown a metre away every 50 frames and the whole body
+    // moved two metres for a frame every 500
+    ClipSampler sampler(&clip);
+    Clip sensorClip = sampler.resample(1 / frameTime);
+    int numKeys = sensorClip.getNumFrames();
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> joints(0, NUM_JOINTS - 1);
+
+    OutlierRejector rejector;
+    float frame[NUM_CHANNELS];
+    float checksum = 0.0f;
+    long injectedJoints = 0;
+    long injectedFrames = 0;
+    double elapsed = 0.0;
+
+    for(int i = 0; i < numFrames; i++) {
+
+        // play the clip back and forth, so it has no seam
+        int key = i % (2 * numKeys - 2);
+        key = key < numKeys ? key : 2 * numKeys - 2 - key;
+        std::copy(sensorClip.getFrame(key), sensorClip.getFrame(key) + NUM_CHANNELS, frame);
+        if(i % 50 == 49) {
+            frame[3 * joints(generator) + 1] += CLIP_SCALE * 1.0f;
+            injectedJoints++;
+        }
+        if(i % 500 == 499) {
+            for(int c = 0; c < NUM_CHANNELS; c += 3) {
+                frame[c] += CLIP_SCALE * 2.0f;
+            }
+            injectedFrames++;
+        }
+
+        benchmarkClock::time_point start = benchmarkClock::now();
+        rejector.process(frame, i * frameTime);
+        elapsed += secondsSince(start);
+        checksum += frame[i % NUM_CHANNELS];
+
+    }
+
+    const RejectionMetrics& metrics = rejector.getMetrics();
+    std::cout << "outlier rejection: " << elapsed / numFrames * 1e9 << " ns per frame, rejected "
+              << metrics.rejectedJoints << " joint samples (" << injectedJoints << " injected) and "
+              << metrics.rejectedFrames << " frames (" << injectedFrames << " injected), " << metrics.resets
+              << " resets (checksum " << checksum << ")" << std::endl;
+
+}
+
+void benchmarkFloor(const Clip& clip) {
+
+    const int numFrames = 1000000;
+    const double frameTime = 1 / 30.0;
+
+    FloorAligner aligner;
+    FootContactSolver solver;
+    float frame[NUM_CHANNELS];
+    float checksum = 0.0f;
+    benchmarkClock::time_point start = benchmarkClock::now();
+    for(int i = 0; i < numFrames; i++) {
+        const float* key = clip.getFrame(i % clip.getNumFrames());
+        std::copy(key, key + NUM_CHANNELS, frame);
+        aligner.observe(frame, i * frameTime);
+        aligner.align(frame);
+        solver.process(frame, i * frameTime);
+        checksum += frame[i % NUM_CHANNELS];
+    }
+    double elapsed = secondsSince(start);
+
+    // horizontal slide of the feet from one key to the next while they are in contact. --benchmark passes the raw
+    // recording, so the untracked foot samples (not gap filled) slide as well.
+    Clip aligned = clip;
+    alignClipToFloor(aligned);
+    Clip pinned = aligned;
+    solver.reset();
+    double slide = 0.0;
+    double pinnedSlide = 0.0;
+    for(int i = 0; i < pinned.getNumFrames(); i++) {
+        solver.process(pinned.getFrame(i), pinned.getTime(i));
+        for(int side = 0; side < 2 && i > 0; side++) {
+            int foot = 3 * (side == 0 ? FOOT_LEFT : FOOT_RIGHT);
+            if(solver.isInContact(side)) {
+                slide += std::hypot(aligned.getFrame(i)[foot] - aligned.getFrame(i - 1)[foot],
+                                    aligned.getFrame(i)[foot + 2] - aligned.getFrame(i - 1)[foot + 2]);
+                pinnedSlide += std::hypot(pinned.getFrame(i)[foot] - pinned.getFrame(i - 1)[foot],
+                                          pinned.getFrame(i)[foot + 2] - pinned.getFrame(i - 1)[foot + 2]);
+            }
+        }
+    }
+
+    std::cout << "floor alignment and foot pinning: " << elapsed / numFrames * 1e9 << " ns per frame, foot slide "
+              << "during contacts " << slide / CLIP_SCALE * 1000 << " mm raw, " << pinnedSlide / CLIP_SCALE * 1000
+              << " mm pinned (checksum " << checksum << ")" << std::endl;
+
+}
+
+void reportKeyframeReduction(const Clip& clip) {
+
+    for(float tolerance : {0.001f, 0.005f, 0.01f, 0.02f, 0.05f}) {
+
+        benchmarkClock::time_point start = benchmarkClock::now();
+        Clip reduced = reduceKeyframes(clip, CLIP_SCALE * tolerance);
+        double elapsed = secondsSince(start);
+
+        std::cout << "keyframe reduction, tolerance " << tolerance * 1000 << " mm: " << reduced.getNumFrames() << "/"
+                  << clip.getNumFrames() << " keys (" << (float)clip.getNumFrames() / reduced.getNumFrames()
+                  << ":1), max error " << getReconstructionError(clip, reduced, SAMPLE_CATMULL_ROM) / CLIP_SCALE * 1000
+                  << " mm catmull-rom (as played back), " << getReconstructionError(clip, reduced, SAMPLE_LINEAR) /
+                  CLIP_SCALE * 1000 << " mm linear, in " << elapsed * 1000 << " ms" << std::endl;
+
+    }
+
+}
+
+void runBenchmarks(const Clip& clip) {
+
+    std::cout << "Benchmarking on " << clip.getNumFrames() << " key frames" << std::endl;
+    benchmarkSampler(clip);
+    benchmarkOrientations();
+    benchmarkBatchResampling(clip);
+    benchmarkSeek(clip);
+    benchmarkBlend(clip);
+    benchmarkOneEuro(clip);
+    benchmarkHolt(clip);
+    benchmarkKalman(clip);
+    benchmarkBoneLengths(clip);
+    benchmarkOutliers(clip);
+    benchmarkFloor(clip);
+    reportKeyframeReduction(clip);
+
+}
@@ -0,0 +1,47 @@
+#ifndef INC_3D_AVATAR_BENCHMARKS_H
+#define INC_3D_AVATAR_BENCHMARKS_H
+
+#include "Clip.h"
+
+// Micro-benchmarks of the animation code, run with "3D_avatar --benchmark". Each one prints its results on stdout.
+
+void benchmarkSampler(const Clip& clip);
+
+// Checks the batched orientation interpolation against the exact slerp and measures its throughput
+void benchmarkOrientations();
+
+// Resamples a library of copies of the clip (some of them long enough to be split in segments) with more and more
+// threads, to show how the batch resampling scales with the cores
+void benchmarkBatchResampling(const Clip& clip);
+
+// Measures random seeks (finding the key and sampling the pose) on a long clip made of copies of the given one
+void benchmarkSeek(const Clip& clip);
+
+// Measures the cost of blending four clip layers per frame, against the 16.7 ms budget of a 60 Hz frame
+void benchmarkBlend(const Clip& clip);
+
+// Times the One Euro filter per frame, measures its lag on constant speed ramps and its jitter reduction on the clip
+void benchmarkOneEuro(const Clip& clip);
+
+// Times the Kinect SDK style smoothing of the clip as one batch, for both presets, with its jitter reduction
+void benchmarkHolt(const Clip& clip);
+
+// Times a Kalman filter bank update per frame for 6 bodies, the most Kinect v2 tracks, and checks its velocity
+void benchmarkKalman(const Clip& clip);
+
+// Times the bone length solver per body and prints how much the bone lengths of the clip vary before and after it
+void benchmarkBoneLengths(const Clip& clip);
+
+// Times the outlier rejection per frame on the clip with teleporting joints and body jumps, and counts what it caught
+void benchmarkOutliers(const Clip& clip);
+
+// Times the floor alignment and the foot contact pinning of live frames, and how much the feet slide during contacts
+void benchmarkFloor(const Clip& clip);
+
+// Prints the compression ratio of the keyframe reduction against its reconstruction error, for a few tolerances
+void reportKeyframeReduction(const Clip& clip);
+
+void runBenchmarks(const Clip& clip);
+
+
+#endif //INC_3D_AVATAR_BENCHMARKS_H
@@ -0,0 +1,121 @@
+#include "BlendEngine.h"
+
+#include <algorithm>
+
+#include "Skeleton.h"
+
+void fillBodyMask(float* mask, bool lowerBody) {
+
+    for(int j = 0; j < NUM_JOINTS; j++) {
+        mask[j] = isLowerBody(j) == lowerBody ? 1.0f : 0.0f;
+    }
+
+}
+
+void blendPoses(const BlendSource* sources, int numSources, float* out) {
+
+    float sum[NUM_CHANNELS] = {};
+    float totalWeight[NUM_CHANNELS] = {};
+    float weights[NUM_CHANNELS];
+
+    for(int s = 0; s < numSources; s++) {
+
+        const BlendSource& source = sources[s];
+        for(int j = 0; j < NUM_JOINTS; j++) {
+            float weight = source.weight * (source.mask ? source.mask[j] : 1.0f);
+            weights[3 * j] = weight;
+            weights[3 * j + 1] = weight;
+            weights[3 * j + 2] = weight;
+        }
+
+        const float* pose = source.pose;
+        for(int c = 0; c < NUM_CHANNELS; c++) {
+            sum[c] += weights[c] * pose[c];
+            totalWeight[c] += weights[c];
+        }
+
+    }
+
+    for(int c = 0; c < NUM_CHANNELS; c++) {
+        out[c] = totalWeight[c] > 0 ? sum[c] / totalWeight[c] : out[c];
+    }
+
+}
+
+int BlendEngine::addLayer(const ClipSampler* sampler, float weight, const float* mask) {
+
+    Layer layer;
+    layer.sampler = sampler;
+    layer.playback.setDuration(sampler->getClip()->getDuration());
+    layer.weight = weight;
+    layer.targetWeight = weight;
+    layer.fadeSpeed = 0.0f;
+    for(int j = 0; j < NUM_JOINTS; j++) {
+        layer.mask[j] = mask ? mask[j] : 1.0f;
+    }
+    layers.push_back(layer);
+
+    return (int)layers.size() - 1;
+
+}
+
+int BlendEngine::getNumLayers() const {
+    return (int)layers.size();
+}
+
+PlaybackController& BlendEngine::getPlayback(int layer) {
+    return layers[layer].playback;
+}
+
+void BlendEngine::setWeight(int layer, float weight) {
+    layers[layer].weight = weight;
+    layers[layer].targetWeight = weight;
+    layers[layer].fadeSpeed = 0.0f;
+}
+
+float BlendEngine::getWeight(int layer) const {
+    return layers[layer].weight;
+}
+
+void BlendEngine::crossfadeTo(int layer, float duration) {
+
+    for(int i = 0; i < (int)layers.size(); i++) {
+        layers[i].targetWeight = i == layer ? 1.0f : 0.0f;
+        layers[i].fadeSpeed = duration > 0 ? 1.0f / duration : 0.0f;
+        if(duration <= 0) {
+            layers[i].weight = layers[i].targetWeight;
+        }
+    }
+
+}
+
+void BlendEngine::update(double elapsed) {
+
+    for(Layer& layer : layers) {
+        layer.playback.update(elapsed);
+        float step = layer.fadeSpeed * (float)elapsed;
+        layer.weight = layer.weight < layer.targetWeight ? std::min(layer.weight + step, layer.targetWeight)
+                                                         : std::max(layer.weight - step, layer.targetWeight);
+    }
+
+}
+
+void BlendEngine::evaluate(float* out) {
+
+    poses.resize(layers.size() * NUM_CHANNELS);
+    sources.clear();
+
+    for(int i = 0; i < (int)layers.size(); i++) {
+        const Layer& layer = layers[i];
+        // layers faded out entirely are not even sampled
+        if(layer.weight <= 0) {
+            continue;
+        }
+        float* pose = &poses[i * NUM_CHANNELS];
+        layer.sampler->sample(layer.sampler->getClip()->getTime(0) + (float)layer.playback.getTime(), pose);
+        sources.push_back({pose, layer.weight, layer.mask});
+    }
+
+    blendPoses(sources.data(), (int)sources.size(), out);
+
+}
@@ -0,0 +1,69 @@
+#ifndef INC_3D_AVATAR_BLENDENGINE_H
+#define INC_3D_AVATAR_BLENDENGINE_H
+
+#include <vector>
+
+#include "Clip.h"
+#include "ClipSampler.h"
+#include "PlaybackController.h"
+
+// One pose taking part in a blend. The mask weighs every joint (1 = driven by this source, 0 = ignored), nullptr
+// means the whole body.
+struct BlendSource {
+    const float* pose;
+    float weight;
+    const float* mask;
+};
+
+// Fills a NUM_JOINTS mask for the lower body (pelvis and legs) or for the rest of it
+void fillBodyMask(float* mask, bool lowerBody);
+
+// Weighted average of the sources, joint by joint. The weights are expanded to one per channel first, so that the
+// accumulation runs over the NUM_CHANNELS floats without any branch. Joints no source drives keep their value in out.
+void blendPoses(const BlendSource* sources, int numSources, float* out);
+
+// Blends several clips playing at the same time, each one with its own playback, weight and mask, and crossfades
+// between them.
+class BlendEngine {
+
+private:
+
+    struct Layer {
+        const ClipSampler* sampler;
+        PlaybackController playback;
+        float weight;
+        float targetWeight;
+        float fadeSpeed;        // weight change per second, while fading
+        float mask[NUM_JOINTS];
+    };
+
+    std::vector<Layer> layers;
+    std::vector<float> poses;
+    std::vector<BlendSource> sources;
+
+public:
+
+    // Adds a clip layer and returns its index. mask may be nullptr for the whole body.
+    int addLayer(const ClipSampler* sampler, float weight, const float* mask = nullptr);
+
+    int getNumLayers() const;
+
+    PlaybackController& getPlayback(int layer);
+
+    void setWeight(int layer, float weight);
+
+    float getWeight(int layer) const;
+
+    // Fades the given layer in and all the others out over duration seconds
+    void crossfadeTo(int layer, float duration);
+
+    // Advances the playbacks and the fades by the given wall-clock time
+    void update(double elapsed);
+
+    // Writes the blended pose of the current frame into out
+    void evaluate(float* out);
+
+};
+
+
+#endif //INC_3D_AVATAR_BLENDENGINE_H
@@ -0,0 +1,134 @@
+#include "BoneLengthSolver.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Skeleton.h"
+
+BoneLengthSolver::BoneLengthSolver(int calibrationFrames) {
+
+    this->calibrationFrames = calibrationFrames;
+    reset();
+
+}
+
+void BoneLengthSolver::reset() {
+
+    numFrames = 0;
+    for(int j = 0; j < NUM_JOINTS; j++) {
+        samples[j].clear();
+        samples[j].reserve(calibrationFrames);
+    }
+    std::fill(boneLengths, boneLengths + NUM_JOINTS, 0.0f);
+    calibrated = false;
+
+}
+
+static float getDistance(const float* a, const float* b) {
+    return std::sqrt((a[0] - b[0]) * (a[0] - b[0]) + (a[1] - b[1]) * (a[1] - b[1]) + (a[2] - b[2]) * (a[2] - b[2]));
+}
+
+void BoneLengthSolver::observe(const float* positions, const unsigned char* trackingStates) {
+
+    if(calibrated) {
+        return;
+    }
+
+    for(int j = 0; j < NUM_JOINTS; j++) {
+        int parent = JOINT_PARENTS[j];
+        if(parent >= 0 && trackingStates[j] == TRACKED && trackingStates[parent] == TRACKED) {
+            samples[j].push_back(getDistance(positions + 3 * j, positions + 3 * parent));
+        }
+    }
+
+    if(++numFrames >= calibrationFrames) {
+        finishCalibration();
+    }
+
+}
+
+void BoneLengthSolver::finishCalibration() {
+
+    // the median ignores the frames where a joint jumped; a bone never seen tracked keeps its measured length
+    for(int j = 0; j < NUM_JOINTS; j++) {
+        std::vector<float>& lengths = samples[j];
+        if(!lengths.empty()) {
+            std::nth_element(lengths.begin(), lengths.begin() + lengths.size() / 2, lengths.end());
+            boneLengths[j] = lengths[lengths.size() / 2];
+        }
+        lengths.clear();
+        lengths.shrink_to_fit();
+    }
+    calibrated = true;
+
+}
+
+void BoneLengthSolver::calibrate(const Clip& clip) {
+
+    reset();
+    for(int i = 0; i < clip.getNumFrames() && !calibrated; i++) {
+        observe(clip.getFrame(i), clip.getTrackingStates(i));
+    }
+    if(!calibrated) {
+        // a recording shorter than the window: calibrate on all of it
+        finishCalibration();
+    }
+
+}
+
+bool BoneLengthSolver::isCalibrated() const {
+    return calibrated;
+}
+
+float BoneLengthSolver::getBoneLength(int joint) const {
+    return boneLengths[joint];
+}
+
+void BoneLengthSolver::solve(float* positions) const {
+
+    // the measured pose, since every joint is moved along with its parent
+    float measured[NUM_CHANNELS];
+    std::copy(positions, positions + NUM_CHANNELS, measured);
+
+    for(int i = 1; i < NUM_JOINTS; i++) {
+
+        int j = JOINT_HIERARCHY_ORDER[i];
+        int parent = JOINT_PARENTS[j];
+        const float* bone = measured + 3 * j;
+        const float* parentMeasured = measured + 3 * parent;
+        float* p = positions + 3 * j;
+        const float* parentSolved = positions + 3 * parent;
+
+        float direction[3] = {bone[0] - parentMeasured[0], bone[1] - parentMeasured[1], bone[2] - parentMeasured[2]};
+        float length = getDistance(bone, parentMeasured);
+        float scale = length > 1e-6f && boneLengths[j] > 0 ? boneLengths[j] / length : 1.0f;
+        for(int c = 0; c < 3; c++) {
+            p[c] = parentSolved[c] + direction[c] * scale;
+        }
+
+    }
+
+}
+
+void BoneLengthSolver::process(BodyFrame& frame) {
+
+    observe(frame.positions, frame.trackingStates);
+    if(calibrated) {
+        solve(frame.positions);
+    }
+
+}
+
+void constrainBoneLengths(Clip& clip, int calibrationFrames) {
+
+    if(clip.getNumFrames() == 0) {
+        return;
+    }
+
+    BoneLengthSolver solver(calibrationFrames);
+    solver.calibrate(clip);
+    for(int i = 0; i < clip.getNumFrames(); i++) {
+        solver.solve(clip.getFrame(i));
+    }
+
+}
@@ -0,0 +1,56 @@
+#ifndef INC_3D_AVATAR_BONELENGTHSOLVER_H
+#define INC_3D_AVATAR_BONELENGTHSOLVER_H
+
+#include <vector>
+
+#include "Clip.h"
+
+// a second of Kinect frames
+const int DEFAULT_CALIBRATION_FRAMES = 30;
+
+// Keeps the bones of the skeleton at constant length: the length of every bone is the median over a calibration
+// window of frames where both its joints are tracked, then each frame is walked from the spine base down and every
+// joint is put at that distance from its (already solved) parent, along the direction the sensor measured.
+class BoneLengthSolver {
+
+private:
+
+    int calibrationFrames;
+    int numFrames;
+    // lengths of every bone over the calibration window, indexed by its child joint
+    std::vector<float> samples[NUM_JOINTS];
+    float boneLengths[NUM_JOINTS];
+    bool calibrated;
+
+    void finishCalibration();
+
+public:
+
+    explicit BoneLengthSolver(int calibrationFrames = DEFAULT_CALIBRATION_FRAMES);
+
+    void reset();
+
+    // Adds a frame to the calibration window, until it is full
+    void observe(const float* positions, const unsigned char* trackingStates);
+
+    // Calibrates from the first frames of a recording at once
+    void calibrate(const Clip& clip);
+
+    bool isCalibrated() const;
+
+    // Length of the bone between a joint and its parent, in clip units
+    float getBoneLength(int joint) const;
+
+    // Moves the joints of a pose onto the calibrated bone lengths, in place
+    void solve(float* positions) const;
+
+    // Calibrates on the live frames, and solves them once calibrated
+    void process(BodyFrame& frame);
+
+};
+
+// Calibrates the bone lengths on a recording and solves all its frames
+void constrainBoneLengths(Clip& clip, int calibrationFrames = DEFAULT_CALIBRATION_FRAMES);
+
+
+#endif //INC_3D_AVATAR_BONELENGTHSOLVER_H
@@ -0,0 +1,93 @@
+#include "BoneRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+const float CYLINDER_PI = 3.14159265f;
+
+BoneRenderer::BoneRenderer(int maxInstances, int slices)
+        : shader("../Shaders/boneVertShader.vert", "../Shaders/fragmentShader.frag"),
+          instanceBuffer(maxInstances * sizeof(BoneInstance)) {
+
+    this->maxInstances = maxInstances;
+    modelUniform = shader.getUniform("model");
+
+    // the unit circle at z = 0 and at z = 1 (the seam is duplicated): x and y are the direction from the axis, z
+    // chooses the end of the bone
+    std::vector<float> vertices;
+    for(int slice = 0; slice <= slices; slice++) {
+        float theta = 2 * CYLINDER_PI * slice / slices;
+        for(float z : {0.0f, 1.0f}) {
+            vertices.insert(vertices.end(), {std::cos(theta), std::sin(theta), z});
+        }
+    }
+
+    std::vector<unsigned int> indices;
+    for(unsigned int slice = 0; slice < (unsigned int)slices; slice++) {
+        unsigned int bottom = 2 * slice;
+        indices.insert(indices.end(), {bottom, bottom + 2, bottom + 1, bottom + 1, bottom + 2, bottom + 3});
+    }
+    numIndices = (int)indices.size();
+
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+
+    glGenBuffers(1, &meshVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, meshVBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+
+    glGenBuffers(1, &meshEBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshEBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+
+    // position on the unit cylinder
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
+    glEnableVertexAttribArray(0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer.getBuffer());
+
+    // start and its radius, end and its radius, then colour, once per instance
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(BoneInstance), nullptr);
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(BoneInstance), (void*)(4 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(BoneInstance), (void*)(8 * sizeof(float)));
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+
+    glBindVertexArray(0);
+
+}
+
+BoneRenderer::~BoneRenderer() {
+
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &meshVBO);
+    glDeleteBuffers(1, &meshEBO);
+
+}
+
+void BoneRenderer::draw(const BoneInstance* instances, int numInstances, const glm::mat4& model) {
+
+    numInstances = std::min(numInstances, maxInstances);
+
+    // the instances go straight into the mapped region, which the draw picks through its base instance
+    std::copy(instances, instances + numInstances, (BoneInstance*)instanceBuffer.begin());
+    GLuint baseInstance = instanceBuffer.getOffset() / sizeof(BoneInstance);
+
+    shader.use();
+    shader.setMat4(modelUniform, model);
+
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    glBindVertexArray(VAO);
+    glDrawElementsInstancedBaseInstance(GL_TRIANGLES, numIndices, GL_UNSIGNED_INT, nullptr, numInstances,
+                                        baseInstance);
+    glBindVertexArray(0);
+    instanceBuffer.end();
+
+}
@@ -0,0 +1,48 @@
+#ifndef INC_3D_AVATAR_BONERENDERER_H
+#define INC_3D_AVATAR_BONERENDERER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "Shader.h"
+#include "StreamingBuffer.h"
+
+// One bone: the centre and radius of both its ends, and its colour, as the instance buffer stores them
+struct BoneInstance {
+    float start[3];
+    float startRadius;
+    float end[3];
+    float endRadius;
+    float color[3];
+};
+
+// Draws the bone cylinders of the skeletons in a single instanced draw call. The mesh is one open unit cylinder
+// along z, built once: the vertex shader stretches and turns it between the two ends of each bone.
+class BoneRenderer {
+
+private:
+
+    Shader shader;
+    UniformHandle modelUniform;
+    unsigned int VAO, meshVBO, meshEBO;
+    StreamingBuffer instanceBuffer;
+    int numIndices;
+    int maxInstances;
+
+public:
+
+    explicit BoneRenderer(int maxInstances, int slices = 32);
+
+    ~BoneRenderer();
+
+    BoneRenderer(const BoneRenderer&) = delete;
+
+    BoneRenderer& operator=(const BoneRenderer&) = delete;
+
+    // Draws numInstances bones (at most maxInstances), moved by the model matrix, with the camera of the frame
+    void draw(const BoneInstance* instances, int numInstances, const glm::mat4& model);
+
+};
+
+
+#endif //INC_3D_AVATAR_BONERENDERER_H
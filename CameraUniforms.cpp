@@ -0,0 +1,25 @@
+#include "CameraUniforms.h"
+
+CameraUniforms::CameraUniforms() {
+
+    // two column-major mat4, which std140 lays out back to back
+    glGenBuffers(1, &UBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+    glBufferData(GL_UNIFORM_BUFFER, 2 * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_BINDING, UBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+}
+
+CameraUniforms::~CameraUniforms() {
+    glDeleteBuffers(1, &UBO);
+}
+
+void CameraUniforms::update(const glm::mat4& projection, const glm::mat4& view) {
+
+    glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), &projection[0][0]);
+    glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::mat4), &view[0][0]);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+}
@@ -0,0 +1,38 @@
+#ifndef INC_3D_AVATAR_CAMERAUNIFORMS_H
+#define INC_3D_AVATAR_CAMERAUNIFORMS_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+// the binding point of the Camera block every vertex shader declares
+const unsigned int CAMERA_BINDING = 0;
+
+// The camera matrices of the frame, shared by all the shader programs through a std140 uniform buffer:
+//
+//     layout (std140, binding = 0) uniform Camera {
+//         mat4 projection;
+//         mat4 view;
+//     };
+class CameraUniforms {
+
+private:
+
+    unsigned int UBO;
+
+public:
+
+    CameraUniforms();
+
+    ~CameraUniforms();
+
+    CameraUniforms(const CameraUniforms&) = delete;
+
+    CameraUniforms& operator=(const CameraUniforms&) = delete;
+
+    // Publishes the matrices of this frame to every program
+    void update(const glm::mat4& projection, const glm::mat4& view);
+
+};
+
+
+#endif //INC_3D_AVATAR_CAMERAUNIFORMS_H
@@ -0,0 +1,327 @@
+#include "Clip.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+void Clip::addFrame(const float* frame, float time, const float* orientation, const unsigned char* states) {
+    positions.insert(positions.end(), frame, frame + NUM_CHANNELS);
+    if(orientation) {
+        orientations.insert(orientations.end(), orientation, orientation + NUM_ORIENTATION_CHANNELS);
+    }
+    if(states) {
+        trackingStates.insert(trackingStates.end(), states, states + NUM_JOINTS);
+    }
+    else {
+        trackingStates.insert(trackingStates.end(), NUM_JOINTS, TRACKED);
+    }
+    times.push_back(time);
+}
+
+void Clip::resize(int numFrames, bool withOrientations) {
+    positions.resize(numFrames * NUM_CHANNELS);
+    orientations.resize(withOrientations ? numFrames * NUM_ORIENTATION_CHANNELS : 0);
+    trackingStates.resize(numFrames * NUM_JOINTS, TRACKED);
+    times.resize(numFrames);
+}
+
+const float* Clip::getFrame(int i) const {
+    return &positions[i * NUM_CHANNELS];
+}
+
+float* Clip::getFrame(int i) {
+    return &positions[i * NUM_CHANNELS];
+}
+
+bool Clip::hasOrientations() const {
+    return !times.empty() && orientations.size() == times.size() * NUM_ORIENTATION_CHANNELS;
+}
+
+const float* Clip::getOrientations(int i) const {
+    return &orientations[i * NUM_ORIENTATION_CHANNELS];
+}
+
+float* Clip::getOrientations(int i) {
+    return &orientations[i * NUM_ORIENTATION_CHANNELS];
+}
+
+void Clip::setOrientations(const std::vector<float>& orientations) {
+    Clip::orientations = orientations;
+}
+
+const unsigned char* Clip::getTrackingStates(int i) const {
+    return &trackingStates[i * NUM_JOINTS];
+}
+
+unsigned char* Clip::getTrackingStates(int i) {
+    return &trackingStates[i * NUM_JOINTS];
+}
+
+void Clip::setTrackingStates(const std::vector<unsigned char>& trackingStates) {
+    Clip::trackingStates = trackingStates;
+}
+
+void Clip::getBodyFrame(int i, BodyFrame& frame) const {
+    std::copy(getFrame(i), getFrame(i) + NUM_CHANNELS, frame.positions);
+    std::copy(getTrackingStates(i), getTrackingStates(i) + NUM_JOINTS, frame.trackingStates);
+    frame.time = times[i];
+    std::fill(frame.floorPlane, frame.floorPlane + 4, 0.0f);
+    if(hasFloorPlane()) {
+        std::copy(floorPlane.begin(), floorPlane.end(), frame.floorPlane);
+    }
+}
+
+float Clip::getTime(int i) const {
+    return times[i];
+}
+
+void Clip::setTime(int i, float time) {
+    times[i] = time;
+}
+
+int Clip::getNumFrames() const {
+    return (int)times.size();
+}
+
+float Clip::getDuration() const {
+    return times.empty() ? 0.0f : times.back() - times.front();
+}
+
+bool Clip::hasFloorPlane() const {
+    return floorPlane.size() == 4;
+}
+
+const float* Clip::getFloorPlane() const {
+    return floorPlane.data();
+}
+
+void Clip::setFloorPlane(const float* plane) {
+    floorPlane.assign(plane, plane + 4);
+}
+
+int Clip::findKey(float t) const {
+    if(times.size() < 2) {
+        return 0;
+    }
+    int key = (int)(std::upper_bound(times.begin(), times.end(), t) - times.begin()) - 1;
+    return std::max(0, std::min(key, (int)times.size() - 2));
+}
+
+// Splits a line of the MatLab table on commas, keeping the empty cells
+static std::vector<std::string> splitRow(const std::string& line) {
+
+    std::vector<std::string> row;
+    std::stringstream s(line);
+    std::string word;
+
+    while(std::getline(s, word, ',')) {
+        row.push_back(word);
+    }
+    if(!line.empty() && line.back() == ',') {
+        row.push_back("");
+    }
+
+    return row;
+
+}
+
+Clip getJointClip(std::string fileName) {
+
+    std::fstream fin;
+    fin.open(fileName, std::ios::in);
+    std::string line;
+    Clip clip;
+    int numRow = 0;
+    // writetable() pads every struct field to the widest one, so the number of Var1_* columns is the frame stride
+    int stride = NUM_CHANNELS;
+    float frame[NUM_CHANNELS];
+    std::vector<float> orientations;
+    std::vector<unsigned char> trackingStates;
+    std::vector<double> timeStamps;
+    std::vector<float> floorPlanes;
+
+    while(std::getline(fin, line)) {
+
+        if(!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        std::vector<std::string> row = splitRow(line);
+
+        if(numRow == 0) {
+            stride = (int)std::count_if(row.begin(), row.end(), [](const std::string& name) {
+                return name.compare(0, 5, "Var1_") == 0;
+            });
+            stride = std::max(stride, NUM_CHANNELS);
+        }
+        // Useful data are at row 1, other data that may be useful are in the next two rows
+        else if(numRow == 1) {
+            for(int i = 0; i + NUM_CHANNELS <= (int)row.size(); i += stride) {
+                try {
+                    for(int j = 0; j < NUM_CHANNELS; j++) {
+                        frame[j] = CLIP_SCALE * std::stof(row[i + j]);
+                    }
+                } catch(std::exception& e) {
+                    // incomplete frame, usually the trailing padding of the table
+                    continue;
+                }
+                clip.addFrame(frame, clip.getNumFrames() / DEFAULT_KEY_RATE);
+            }
+        }
+        // Older exports wrote the positions again in place of the orientations: real quaternions make the frames
+        // NUM_ORIENTATION_CHANNELS wide
+        else if(numRow == 2 && stride >= NUM_ORIENTATION_CHANNELS) {
+            for(int i = 0; i + NUM_ORIENTATION_CHANNELS <= (int)row.size(); i += stride) {
+                try {
+                    for(int j = 0; j < NUM_ORIENTATION_CHANNELS; j++) {
+                        orientations.push_back(std::stof(row[i + j]));
+                    }
+                } catch(std::exception& e) {
+                    orientations.resize(orientations.size() - orientations.size() % NUM_ORIENTATION_CHANNELS);
+                }
+            }
+        }
+        else if(numRow == 3) {
+            for(int i = 0; i + NUM_JOINTS <= (int)row.size(); i += stride) {
+                try {
+                    for(int j = 0; j < NUM_JOINTS; j++) {
+                        trackingStates.push_back((unsigned char)std::stoi(row[i + j]));
+                    }
+                } catch(std::exception& e) {
+                    trackingStates.resize(trackingStates.size() - trackingStates.size() % NUM_JOINTS);
+                }
+            }
+        }
+        // Newer exports also carry the body frame timestamp at row 4
+        else if(numRow == 4) {
+            for(int i = 0; i < (int)row.size(); i += stride) {
+                try {
+                    timeStamps.push_back(std::stod(row[i]));
+                } catch(std::exception& e) {
+                    continue;
+                }
+            }
+        }
+        // and the floor clip plane at row 5
+        else if(numRow == 5) {
+            for(int i = 0; i + 4 <= (int)row.size(); i += stride) {
+                try {
+                    for(int j = 0; j < 4; j++) {
+                        floorPlanes.push_back(std::stof(row[i + j]));
+                    }
+                } catch(std::exception& e) {
+                    floorPlanes.resize(floorPlanes.size() - floorPlanes.size() % 4);
+                }
+            }
+        }
+        numRow++;
+
+    }
+
+    if(orientations.size() == (size_t)clip.getNumFrames() * NUM_ORIENTATION_CHANNELS) {
+        clip.setOrientations(orientations);
+    }
+    if(trackingStates.size() == (size_t)clip.getNumFrames() * NUM_JOINTS) {
+        clip.setTrackingStates(trackingStates);
+    }
+
+    // the sensor doesn't move during a recording: its floor plane is the mean of the per-frame ones it found. Frames
+    // where it saw no floor report a zero plane.
+    float plane[4] = {};
+    int numPlanes = 0;
+    for(size_t i = 0; i < floorPlanes.size(); i += 4) {
+        if(floorPlanes[i + 1] > 0) {
+            for(int j = 0; j < 4; j++) {
+                plane[j] += floorPlanes[i + j];
+            }
+            numPlanes++;
+        }
+    }
+    if(numPlanes > 0) {
+        float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        for(int j = 0; j < 4; j++) {
+            plane[j] /= length;
+        }
+        clip.setFloorPlane(plane);
+    }
+
+    // timestamps are only trusted when there is one per frame and they are strictly increasing
+    bool validTimeStamps = (int)timeStamps.size() == clip.getNumFrames();
+    for(int i = 1; validTimeStamps && i < (int)timeStamps.size(); i++) {
+        validTimeStamps = timeStamps[i] > timeStamps[i - 1];
+    }
+    if(validTimeStamps) {
+        for(int i = 0; i < clip.getNumFrames(); i++) {
+            clip.setTime(i, (float)((timeStamps[i] - timeStamps[0]) / KINECT_TICKS_PER_SECOND));
+        }
+    }
+
+    return clip;
+
+}
+
+// Writes one row of the MatLab table: the first width columns of every frame come from value(frame, column), the
+// remaining ones up to the stride are left empty like writetable() does
+template<typename ValueFunction>
+static void writeRow(std::ofstream& fout, int numFrames, int stride, int width, ValueFunction value) {
+
+    for(int i = 0; i < numFrames; i++) {
+        for(int j = 0; j < stride; j++) {
+            if(i + j != 0) {
+                fout << ",";
+            }
+            if(j < width) {
+                fout << value(i, j);
+            }
+        }
+    }
+    fout << "\n";
+
+}
+
+void writeJointClip(std::string fileName, const Clip& clip) {
+
+    std::ofstream fout(fileName);
+    fout.precision(15);
+    int numFrames = clip.getNumFrames();
+    int stride = clip.hasOrientations() ? NUM_ORIENTATION_CHANNELS : NUM_CHANNELS;
+
+    // Same layout MatLab's writetable() produces: a header, then one row per struct field (Position, Orientation,
+    // TrackingState, TimeStamp and FloorClipPlane)
+    for(int i = 0; i < numFrames; i++) {
+        for(int j = 0; j < stride; j++) {
+            fout << (i + j == 0 ? "" : ",") << "Var" << i + 1 << "_" << j + 1;
+        }
+    }
+    fout << "\n";
+
+    writeRow(fout, numFrames, stride, NUM_CHANNELS, [&clip](int i, int j) {
+        return clip.getFrame(i)[j] / CLIP_SCALE;
+    });
+    if(clip.hasOrientations()) {
+        writeRow(fout, numFrames, stride, NUM_ORIENTATION_CHANNELS, [&clip](int i, int j) {
+            return clip.getOrientations(i)[j];
+        });
+    }
+    else {
+        writeRow(fout, numFrames, stride, NUM_CHANNELS, [&clip](int i, int j) {
+            return clip.getFrame(i)[j] / CLIP_SCALE;
+        });
+    }
+    writeRow(fout, numFrames, stride, NUM_JOINTS, [&clip](int i, int j) {
+        return (int)clip.getTrackingStates(i)[j];
+    });
+
+    fout.precision(17);
+    writeRow(fout, numFrames, stride, 1, [&clip](int i, int) {
+        return (double)clip.getTime(i) * KINECT_TICKS_PER_SECOND;
+    });
+
+    if(clip.hasFloorPlane()) {
+        fout.precision(15);
+        writeRow(fout, numFrames, stride, 4, [&clip](int, int j) {
+            return clip.getFloorPlane()[j];
+        });
+    }
+
+}
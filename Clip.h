@@ -0,0 +1,109 @@
+#ifndef INC_3D_AVATAR_CLIP_H
+#define INC_3D_AVATAR_CLIP_H
+
+#include <string>
+#include <vector>
+
+// Kinect v2 tracks 25 joints per body, each one with x, y and z coordinates
+const int NUM_JOINTS = 25;
+const int NUM_CHANNELS = 3 * NUM_JOINTS;
+// joint orientations are quaternions, stored as x, y, z, w
+const int NUM_ORIENTATION_CHANNELS = 4 * NUM_JOINTS;
+
+// Joint positions are doubled when loaded to make the skeleton bigger and hence more visible
+const float CLIP_SCALE = 2.0f;
+
+// When the MatLab export carries no timestamps, key poses are assumed to be this many per second apart. 6 keys per
+// second is the speed the old "10 in-between frames at 60 FPS" playback used to have.
+const float DEFAULT_KEY_RATE = 6.0f;
+
+// Kinect timestamps are TIMESPANs, expressed in 100 ns ticks
+const double KINECT_TICKS_PER_SECOND = 1e7;
+
+// Per-joint tracking states of the TrackingState row, as Kinect reports them
+enum TrackingState {
+    NOT_TRACKED = 0,
+    INFERRED = 1,
+    TRACKED = 2
+};
+
+// A single skeleton frame, as the live processing stages see it
+struct BodyFrame {
+    float positions[NUM_CHANNELS];
+    unsigned char trackingStates[NUM_JOINTS];
+    double time;
+    float floorPlane[4];        // the sensor's floor clip plane (see Clip::getFloorPlane()), all zero when unknown
+};
+
+// A recorded sequence of key poses. Poses are stored contiguously, NUM_CHANNELS floats per frame (x, y, z of every
+// joint), so that any key can be reached in constant time and handed to the samplers without copies.
+class Clip {
+
+private:
+
+    std::vector<float> positions;
+    std::vector<float> orientations;
+    std::vector<unsigned char> trackingStates;
+    std::vector<float> times;
+    // the sensor's floor clip plane, empty when the export has none
+    std::vector<float> floorPlane;
+
+public:
+
+    Clip() = default;
+
+    // Sets the number of frames, e.g. to fill them in parallel afterwards
+    void resize(int numFrames, bool withOrientations);
+
+    // orientation, when given, holds the NUM_ORIENTATION_CHANNELS quaternion components of the frame. Without
+    // states, every joint is considered TRACKED.
+    void addFrame(const float* frame, float time, const float* orientation = nullptr,
+                  const unsigned char* states = nullptr);
+
+    const float* getFrame(int i) const;
+
+    float* getFrame(int i);
+
+    bool hasOrientations() const;
+
+    const float* getOrientations(int i) const;
+
+    float* getOrientations(int i);
+
+    void setOrientations(const std::vector<float>& orientations);
+
+    const unsigned char* getTrackingStates(int i) const;
+
+    unsigned char* getTrackingStates(int i);
+
+    void setTrackingStates(const std::vector<unsigned char>& trackingStates);
+
+    float getTime(int i) const;
+
+    void setTime(int i, float time);
+
+    int getNumFrames() const;
+
+    float getDuration() const;
+
+    // Floor plane in camera space and metres, as Kinect reports it: x X + y Y + z Z + w = 0, with (x, y, z) the up
+    // direction and w the height of the sensor above the floor
+    bool hasFloorPlane() const;
+
+    const float* getFloorPlane() const;
+
+    void setFloorPlane(const float* plane);
+
+    void getBodyFrame(int i, BodyFrame& frame) const;
+
+    // Returns the index k of the key such that getTime(k) <= t < getTime(k + 1), clamped to the valid segments
+    int findKey(float t) const;
+
+};
+
+// data management functions
+Clip getJointClip(std::string fileName);
+void writeJointClip(std::string fileName, const Clip& clip);
+
+
+#endif //INC_3D_AVATAR_CLIP_H
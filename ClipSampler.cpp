@@ -0,0 +1,191 @@
+#include "ClipSampler.h"
+#include "Orientation.h"
+
+#include <algorithm>
+#include <cmath>
+
+const Clip* ClipSampler::getClip() const {
+    return clip;
+}
+
+SampleMode ClipSampler::getMode() const {
+    return mode;
+}
+
+void ClipSampler::setMode(SampleMode mode) {
+    ClipSampler::mode = mode;
+}
+
+void ClipSampler::update() {
+
+    int numFrames = clip->getNumFrames();
+    coefficients.assign(std::max(numFrames - 1, 0) * 4 * NUM_CHANNELS, 0.0f);
+
+    keyIndex.assign(numFrames + 1, 0);
+    bucketsPerSecond = clip->getDuration() > 0 ? numFrames / clip->getDuration() : 0.0f;
+    for(int b = 0, k = 0; b <= numFrames && numFrames > 1; b++) {
+        float t = clip->getTime(0) + b / bucketsPerSecond;
+        while(k + 2 < numFrames && clip->getTime(k + 1) <= t) {
+            k++;
+        }
+        keyIndex[b] = k;
+    }
+
+    for(int k = 0; k + 1 < numFrames; k++) {
+
+        // Catmull-Rom tangents (per second) from the neighbouring keys, which keeps the velocity continuous even when
+        // the keys are not evenly spaced. The first and last keys use one-sided differences.
+        int prev = std::max(k - 1, 0);
+        int next = std::min(k + 2, numFrames - 1);
+        float span = clip->getTime(k + 1) - clip->getTime(k);
+        float scale0 = span / (clip->getTime(k + 1) - clip->getTime(prev));
+        float scale1 = span / (clip->getTime(next) - clip->getTime(k));
+
+        const float* p0 = clip->getFrame(prev);
+        const float* p1 = clip->getFrame(k);
+        const float* p2 = clip->getFrame(k + 1);
+        const float* p3 = clip->getFrame(next);
+
+        float* a = &coefficients[k * 4 * NUM_CHANNELS];
+        float* b = a + NUM_CHANNELS;
+        float* c = b + NUM_CHANNELS;
+        float* d = c + NUM_CHANNELS;
+        for(int i = 0; i < NUM_CHANNELS; i++) {
+            float m1 = (p2[i] - p0[i]) * scale0;
+            float m2 = (p3[i] - p1[i]) * scale1;
+            a[i] = 2 * p1[i] - 2 * p2[i] + m1 + m2;
+            b[i] = 3 * p2[i] - 3 * p1[i] - 2 * m1 - m2;
+            c[i] = m1;
+            d[i] = p1[i];
+        }
+
+    }
+
+}
+
+int ClipSampler::findKey(float t) const {
+
+    int numFrames = clip->getNumFrames();
+    if(numFrames < 2) {
+        return 0;
+    }
+
+    float bucket = (t - clip->getTime(0)) * bucketsPerSecond;
+    int k = keyIndex[bucket <= 0 ? 0 : std::min((int)bucket, numFrames)];
+    while(k + 2 < numFrames && clip->getTime(k + 1) <= t) {
+        k++;
+    }
+    return k;
+
+}
+
+void ClipSampler::sample(float t, float* out) const {
+
+    int numFrames = clip->getNumFrames();
+    if(numFrames == 0) {
+        return;
+    }
+    if(numFrames == 1) {
+        std::copy(clip->getFrame(0), clip->getFrame(0) + NUM_CHANNELS, out);
+        return;
+    }
+
+    int k = findKey(t);
+    float t1 = clip->getTime(k);
+    float t2 = clip->getTime(k + 1);
+    float u = std::max(0.0f, std::min((t - t1) / (t2 - t1), 1.0f));
+
+    if(mode == SAMPLE_LINEAR) {
+        const float* p1 = clip->getFrame(k);
+        const float* p2 = clip->getFrame(k + 1);
+        for(int i = 0; i < NUM_CHANNELS; i++) {
+            out[i] = p1[i] + (p2[i] - p1[i]) * u;
+        }
+        return;
+    }
+
+    const float* a = &coefficients[k * 4 * NUM_CHANNELS];
+    const float* b = a + NUM_CHANNELS;
+    const float* c = b + NUM_CHANNELS;
+    const float* d = c + NUM_CHANNELS;
+    for(int i = 0; i < NUM_CHANNELS; i++) {
+        out[i] = ((a[i] * u + b[i]) * u + c[i]) * u + d[i];
+    }
+
+}
+
+void ClipSampler::sampleOrientations(float t, float* out) const {
+
+    int numFrames = clip->getNumFrames();
+    if(!clip->hasOrientations()) {
+        return;
+    }
+    if(numFrames == 1) {
+        std::copy(clip->getOrientations(0), clip->getOrientations(0) + NUM_ORIENTATION_CHANNELS, out);
+        return;
+    }
+
+    int k = findKey(t);
+    float t1 = clip->getTime(k);
+    float t2 = clip->getTime(k + 1);
+    float u = std::max(0.0f, std::min((t - t1) / (t2 - t1), 1.0f));
+
+    interpolateOrientations(clip->getOrientations(k), clip->getOrientations(k + 1), u, out);
+
+}
+
+void ClipSampler::sampleLooped(float t, float* out) const {
+
+    float duration = clip->getDuration();
+    if(duration > 0) {
+        t = std::fmod(t, duration);
+        if(t < 0) {
+            t += duration;
+        }
+    }
+    sample(clip->getNumFrames() > 0 ? clip->getTime(0) + t : t, out);
+
+}
+
+Clip ClipSampler::resample(float rate) const {
+
+    Clip result;
+    int numFrames = getNumResampledFrames(rate);
+    result.resize(numFrames, clip->hasOrientations());
+    if(clip->hasFloorPlane()) {
+        result.setFloorPlane(clip->getFloorPlane());
+    }
+    resampleInto(rate, 0, numFrames, result);
+
+    return result;
+
+}
+
+int ClipSampler::getNumResampledFrames(float rate) const {
+    return clip->getNumFrames() == 0 ? 0 : (int)std::floor(clip->getDuration() * rate) + 1;
+}
+
+void ClipSampler::resampleInto(float rate, int first, int last, Clip& result) const {
+
+    if(clip->getNumFrames() == 0 || first >= last) {
+        return;
+    }
+
+    float start = clip->getTime(0);
+    bool hasOrientations = clip->hasOrientations() && result.hasOrientations();
+
+    for(int i = first; i < last; i++) {
+        sample(start + i / rate, result.getFrame(i));
+        if(hasOrientations) {
+            sampleOrientations(start + i / rate, result.getOrientations(i));
+        }
+        // an in-between joint is only as reliable as the worse of its two keys
+        int k = findKey(start + i / rate);
+        int next = std::min(k + 1, clip->getNumFrames() - 1);
+        for(int j = 0; j < NUM_JOINTS; j++) {
+            result.getTrackingStates(i)[j] = std::min(clip->getTrackingStates(k)[j], clip->getTrackingStates(next)[j]);
+        }
+        result.setTime(i, i / rate);
+    }
+
+}
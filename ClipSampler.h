@@ -0,0 +1,75 @@
+#ifndef INC_3D_AVATAR_CLIPSAMPLER_H
+#define INC_3D_AVATAR_CLIPSAMPLER_H
+
+#include <vector>
+
+#include "Clip.h"
+
+enum SampleMode {
+    SAMPLE_LINEAR,          // two surrounding keys
+    SAMPLE_CATMULL_ROM      // four surrounding keys, through precomputed cubic coefficients
+};
+
+// Computes the pose of a clip at an arbitrary time on demand, so that no in-between frame is ever stored.
+class ClipSampler {
+
+private:
+
+    const Clip* clip;
+    SampleMode mode;
+
+    // Cubic Hermite coefficients (a, b, c, d) of every segment, stored as 4 blocks of NUM_CHANNELS floats per segment,
+    // so that p(u) = ((a * u + b) * u + c) * u + d, with u in [0, 1] along the segment
+    std::vector<float> coefficients;
+
+    // Seek index: keyIndex[b] is the key in effect at the start of bucket b. With as many buckets as keys, finding the
+    // key of any time takes a lookup and, unless the keys are very unevenly spaced, a step or two.
+    std::vector<int> keyIndex;
+    float bucketsPerSecond;
+
+public:
+
+    explicit ClipSampler(const Clip* clip, SampleMode mode = SAMPLE_CATMULL_ROM) {
+
+        this->clip = clip;
+        this->mode = mode;
+        update();
+
+    }
+
+    const Clip* getClip() const;
+
+    SampleMode getMode() const;
+
+    void setMode(SampleMode mode);
+
+    // Recomputes the spline coefficients and the seek index, to be called whenever the clip changes
+    void update();
+
+    // Constant-time equivalent of Clip::findKey()
+    int findKey(float t) const;
+
+    // Writes the NUM_CHANNELS coordinates of the pose at time t (in seconds, clamped to the clip) into out
+    void sample(float t, float* out) const;
+
+    // Writes the NUM_ORIENTATION_CHANNELS quaternion components of the joints at time t into out, when the clip has
+    // orientations
+    void sampleOrientations(float t, float* out) const;
+
+    // Same as sample(), but t wraps around the end of the clip
+    void sampleLooped(float t, float* out) const;
+
+    // Resamples the whole clip at a constant rate (in frames per second), e.g. for exporting
+    Clip resample(float rate) const;
+
+    // Number of frames resample() produces at the given rate
+    int getNumResampledFrames(float rate) const;
+
+    // Computes the resampled frames [first, last) into a clip already sized by Clip::resize(), so that the segments
+    // of a long clip can be resampled in parallel
+    void resampleInto(float rate, int first, int last, Clip& result) const;
+
+};
+
+
+#endif //INC_3D_AVATAR_CLIPSAMPLER_H
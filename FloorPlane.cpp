@@ -0,0 +1,209 @@
+#include "FloorPlane.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Skeleton.h"
+
+// how fast the estimated floor rises back under the live feet, in metres per second
+const float FLOOR_RELAXATION = 0.02f;
+
+// the lower of the two feet, which is on the floor most of the time
+static float getLowestFoot(const float* positions) {
+    return std::min(positions[3 * FOOT_LEFT + 1], positions[3 * FOOT_RIGHT + 1]);
+}
+
+FloorAligner::FloorAligner() {
+
+    reset();
+
+}
+
+void FloorAligner::reset() {
+
+    std::fill(rotation, rotation + 9, 0.0f);
+    rotation[0] = rotation[4] = rotation[8] = 1.0f;
+    height = 0.0f;
+    planeKnown = false;
+    estimated = false;
+    lastTime = 0.0;
+
+}
+
+void FloorAligner::setFloorPlane(const float* plane) {
+
+    // the rotation taking the normal n onto the up axis u (Rodrigues): R = I + [v]x + [v]x^2 / (1 + c), with
+    // v = n x u and c = n . u
+    float n[3] = {plane[0], plane[1], plane[2]};
+    float v[3] = {-n[2], 0.0f, n[0]};
+    float k = 1 / (1 + n[1]);
+    float cross[9] = {0.0f, -v[2], v[1], v[2], 0.0f, -v[0], -v[1], v[0], 0.0f};
+
+    for(int r = 0; r < 3; r++) {
+        for(int c = 0; c < 3; c++) {
+            float square = 0.0f;
+            for(int i = 0; i < 3; i++) {
+                square += cross[3 * r + i] * cross[3 * i + c];
+            }
+            rotation[3 * r + c] = (r == c ? 1.0f : 0.0f) + cross[3 * r + c] + square * k;
+        }
+    }
+
+    // the rotated height of a point is n . p, so the floor (n . p = -w) ends up at y = 0 once w is added
+    height = CLIP_SCALE * plane[3];
+    planeKnown = true;
+
+}
+
+bool FloorAligner::hasFloorPlane() const {
+    return planeKnown;
+}
+
+void FloorAligner::estimateFloor(const Clip& clip) {
+
+    if(planeKnown || clip.getNumFrames() == 0) {
+        return;
+    }
+
+    std::vector<float> feet(clip.getNumFrames());
+    for(int i = 0; i < clip.getNumFrames(); i++) {
+        feet[i] = getLowestFoot(clip.getFrame(i));
+    }
+    std::nth_element(feet.begin(), feet.begin() + feet.size() / 20, feet.end());
+    height = -feet[feet.size() / 20];
+    estimated = true;
+
+}
+
+void FloorAligner::observe(const float* positions, double time) {
+
+    if(planeKnown) {
+        return;
+    }
+
+    float foot = getLowestFoot(positions);
+    if(!estimated) {
+        height = -foot;
+        estimated = true;
+    }
+    else {
+        float rise = CLIP_SCALE * FLOOR_RELAXATION * (float)std::max(0.0, time - lastTime);
+        height = std::max(-foot, height - rise);
+    }
+    lastTime = time;
+
+}
+
+void FloorAligner::align(float* positions) const {
+
+    for(int j = 0; j < NUM_JOINTS; j++) {
+        float* p = positions + 3 * j;
+        float x = rotation[0] * p[0] + rotation[1] * p[1] + rotation[2] * p[2];
+        float y = rotation[3] * p[0] + rotation[4] * p[1] + rotation[5] * p[2];
+        float z = rotation[6] * p[0] + rotation[7] * p[1] + rotation[8] * p[2];
+        p[0] = x;
+        p[1] = y + height;
+        p[2] = z;
+    }
+
+}
+
+void alignClipToFloor(Clip& clip) {
+
+    FloorAligner aligner;
+    if(clip.hasFloorPlane()) {
+        aligner.setFloorPlane(clip.getFloorPlane());
+    }
+    else {
+        aligner.estimateFloor(clip);
+    }
+    for(int i = 0; i < clip.getNumFrames(); i++) {
+        aligner.align(clip.getFrame(i));
+    }
+
+}
+
+// the ankle and the foot of each side, left then right
+static const int FOOT_JOINTS[2][2] = {{ANKLE_LEFT, FOOT_LEFT}, {ANKLE_RIGHT, FOOT_RIGHT}};
+
+FootContactSolver::FootContactSolver(const FootContactSettings& settings) {
+
+    this->settings = settings;
+    reset();
+
+}
+
+void FootContactSolver::reset() {
+
+    for(int side = 0; side < 2; side++) {
+        std::fill(previous[side], previous[side] + 6, 0.0f);
+        std::fill(correction[side], correction[side] + 6, 0.0f);
+        inContact[side] = false;
+    }
+    lastTime = 0.0;
+    initialized = false;
+
+}
+
+bool FootContactSolver::isInContact(int side) const {
+    return inContact[side];
+}
+
+void FootContactSolver::process(float* positions, double time) {
+
+    float dt = initialized && time > lastTime ? (float)(time - lastTime) : 0.0f;
+    float maxStep = CLIP_SCALE * settings.maxSpeed * dt;
+    float maxHeight = CLIP_SCALE * settings.maxHeight;
+    float release = dt > 0 ? std::exp(-dt / settings.releaseTime) : 1.0f;
+
+    for(int side = 0; side < 2; side++) {
+
+        float measured[6];
+        for(int k = 0; k < 2; k++) {
+            std::copy(positions + 3 * FOOT_JOINTS[side][k], positions + 3 * FOOT_JOINTS[side][k] + 3, measured + 3 * k);
+        }
+
+        // both joints have to be still, and the foot low; a contact ends once they move 1.5 times faster than that
+        float step2[2] = {};
+        for(int c = 0; c < 6; c++) {
+            step2[c / 3] += (measured[c] - previous[side][c]) * (measured[c] - previous[side][c]);
+        }
+        float limit = inContact[side] ? 1.5f * maxStep : maxStep;
+        bool contact = dt > 0 && step2[0] <= limit * limit && step2[1] <= limit * limit && measured[4] <= maxHeight;
+
+        if(contact && !inContact[side]) {
+            // pin the foot where it is drawn now, so the contact starts without a jump
+            for(int c = 0; c < 6; c++) {
+                pinned[side][c] = measured[c] + correction[side][c];
+            }
+        }
+        inContact[side] = contact;
+
+        for(int c = 0; c < 6; c++) {
+            correction[side][c] = contact ? pinned[side][c] - measured[c] : correction[side][c] * release;
+            positions[3 * FOOT_JOINTS[side][c / 3] + c % 3] = measured[c] + correction[side][c];
+        }
+        std::copy(measured, measured + 6, previous[side]);
+
+    }
+
+    lastTime = time;
+    initialized = true;
+
+}
+
+void FootContactSolver::process(BodyFrame& frame) {
+
+    process(frame.positions, frame.time);
+
+}
+
+void pinFootContacts(Clip& clip, const FootContactSettings& settings) {
+
+    FootContactSolver solver(settings);
+    for(int i = 0; i < clip.getNumFrames(); i++) {
+        solver.process(clip.getFrame(i), clip.getTime(i));
+    }
+
+}
@@ -0,0 +1,89 @@
+#ifndef INC_3D_AVATAR_FLOORPLANE_H
+#define INC_3D_AVATAR_FLOORPLANE_H
+
+#include "Clip.h"
+
+// Puts the skeleton on the floor: camera space is rotated so that the floor's normal points up, and moved so that
+// the floor is at y = 0. The floor is the sensor's floor clip plane when the export has one; otherwise it is taken as
+// horizontal, under the lowest foot.
+class FloorAligner {
+
+private:
+
+    // rotation from camera space to floor space, row-major, and the height of the camera above the floor
+    float rotation[9];
+    float height;
+    bool planeKnown;
+    bool estimated;
+    double lastTime;
+
+public:
+
+    FloorAligner();
+
+    void reset();
+
+    // Uses a floor clip plane (in metres, see Clip::getFloorPlane())
+    void setFloorPlane(const float* plane);
+
+    bool hasFloorPlane() const;
+
+    // Without a floor plane, a horizontal floor under the lowest 5% of the feet of a recording
+    void estimateFloor(const Clip& clip);
+
+    // Without a floor plane, follows the lowest foot of the live frames: the floor drops at once to a lower foot, and
+    // rises slowly back in case that one was noise
+    void observe(const float* positions, double time);
+
+    // Moves the 75 positions of a pose from camera space to floor space, in place
+    void align(float* positions) const;
+
+};
+
+// Aligns every frame of a recording on its floor clip plane, or on the floor estimated from its feet
+void alignClipToFloor(Clip& clip);
+
+struct FootContactSettings {
+    float maxSpeed;             // the ankle and the foot are slower than this during a contact, in metres per second
+    float maxHeight;            // and the foot lower than this above the floor, in metres
+    float releaseTime;          // time constant of the return to the measured foot after a contact, in seconds
+};
+
+const FootContactSettings DEFAULT_FOOT_CONTACT = {0.3f, 0.12f, 0.1f};
+
+// Removes foot skating on a floor-aligned skeleton: a foot whose ankle and foot joints stand still near the floor is
+// in contact, and both joints are pinned where the contact started until it lifts off, then eased back.
+class FootContactSolver {
+
+private:
+
+    FootContactSettings settings;
+
+    // per side (left, right): the last measured ankle and foot, the pinned ones and the current correction
+    float previous[2][6];
+    float pinned[2][6];
+    float correction[2][6];
+    bool inContact[2];
+    double lastTime;
+    bool initialized;
+
+public:
+
+    explicit FootContactSolver(const FootContactSettings& settings = DEFAULT_FOOT_CONTACT);
+
+    void reset();
+
+    bool isInContact(int side) const;
+
+    // Pins the feet of a floor-aligned pose taken at time (in seconds), in place
+    void process(float* positions, double time);
+
+    void process(BodyFrame& frame);
+
+};
+
+// Pins the feet of every frame of a floor-aligned recording
+void pinFootContacts(Clip& clip, const FootContactSettings& settings = DEFAULT_FOOT_CONTACT);
+
+
+#endif //INC_3D_AVATAR_FLOORPLANE_H
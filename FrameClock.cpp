@@ -0,0 +1,45 @@
+#include "FrameClock.h"
+
+#include <algorithm>
+#include <cmath>
+
+void FrameClock::onSwap(double time) {
+
+    if(numSwaps > 0) {
+        double elapsed = time - lastSwap;
+        // a missed refresh makes the interval a multiple of the real one
+        double refreshes = std::max(1.0, std::round(elapsed / refreshInterval));
+        double measured = elapsed / refreshes;
+        // swaps much longer than a few refreshes (window moved, breakpoint...) say nothing about the display
+        if(refreshes <= 4) {
+            refreshInterval += (measured - refreshInterval) * (numSwaps < 10 ? 0.5 : 0.05);
+        }
+    }
+
+    lastSwap = time;
+    numSwaps++;
+
+}
+
+double FrameClock::getRefreshInterval() const {
+    return refreshInterval;
+}
+
+double FrameClock::getPresentTime(double now) const {
+
+    if(numSwaps == 0) {
+        return now;
+    }
+    double refreshes = std::max(1.0, std::ceil((now - lastSwap) / refreshInterval));
+    return lastSwap + refreshes * refreshInterval;
+
+}
+
+double FrameClock::advance(double now) {
+
+    double present = getPresentTime(now);
+    double elapsed = lastPresent > 0 ? present - lastPresent : 0.0;
+    lastPresent = present;
+    return std::max(elapsed, 0.0);
+
+}
@@ -0,0 +1,43 @@
+#ifndef INC_3D_AVATAR_FRAMECLOCK_H
+#define INC_3D_AVATAR_FRAMECLOCK_H
+
+// Tracks the buffer swaps to estimate the actual refresh interval of the display, so that the animation can be sampled
+// at the time each frame is going to be shown instead of advancing one step per rendered frame. This way the clip
+// plays at the same wall-clock speed, and just as smoothly, at 60, 120 or 144 Hz.
+class FrameClock {
+
+private:
+
+    double refreshInterval;
+    double lastSwap;
+    double lastPresent;
+    int numSwaps;
+
+public:
+
+    // refreshRate is the nominal refresh rate of the monitor, in Hz, used until enough swaps have been measured
+    explicit FrameClock(double refreshRate) {
+
+        this->refreshInterval = refreshRate > 0 ? 1.0 / refreshRate : 1.0 / 60;
+        this->lastSwap = 0.0;
+        this->lastPresent = 0.0;
+        this->numSwaps = 0;
+
+    }
+
+    // To be called right after glfwSwapBuffers(), with the current time in seconds
+    void onSwap(double time);
+
+    double getRefreshInterval() const;
+
+    // Predicts when the frame being rendered now will reach the screen: the first refresh after the last swap that
+    // is still ahead of now
+    double getPresentTime(double now) const;
+
+    // Advances to the next frame and returns the time between its predicted presentation and the previous one
+    double advance(double now);
+
+};
+
+
+#endif //INC_3D_AVATAR_FRAMECLOCK_H
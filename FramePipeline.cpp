@@ -0,0 +1,173 @@
+#include "FramePipeline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+#include "FrameStages.h"
+
+typedef std::chrono::steady_clock pipelineClock;
+
+int FrameStage::processClip(Clip& clip) {
+
+    reset();
+    BodyFrame frame;
+    std::vector<bool> kept(clip.getNumFrames());
+    int numDropped = 0;
+    for(int i = 0; i < clip.getNumFrames(); i++) {
+        clip.getBodyFrame(i, frame);
+        kept[i] = process(frame);
+        numDropped += !kept[i];
+        std::copy(frame.positions, frame.positions + NUM_CHANNELS, clip.getFrame(i));
+        std::copy(frame.trackingStates, frame.trackingStates + NUM_JOINTS, clip.getTrackingStates(i));
+    }
+
+    if(numDropped > 0) {
+        Clip remaining;
+        if(clip.hasFloorPlane()) {
+            remaining.setFloorPlane(clip.getFloorPlane());
+        }
+        for(int i = 0; i < clip.getNumFrames(); i++) {
+            if(kept[i]) {
+                remaining.addFrame(clip.getFrame(i), clip.getTime(i),
+                                   clip.hasOrientations() ? clip.getOrientations(i) : nullptr, clip.getTrackingStates(i));
+            }
+        }
+        clip = std::move(remaining);
+    }
+    return numDropped;
+
+}
+
+void FramePipeline::addStage(std::unique_ptr<FrameStage> stage) {
+
+    statistics.push_back({stage->getName(), 0, 0, 0.0});
+    stages.push_back(std::move(stage));
+
+}
+
+int FramePipeline::getNumStages() const {
+    return (int)stages.size();
+}
+
+FrameStage* FramePipeline::findStage(const std::string& name) const {
+
+    for(const std::unique_ptr<FrameStage>& stage : stages) {
+        if(name == stage->getName()) {
+            return stage.get();
+        }
+    }
+    return nullptr;
+
+}
+
+void FramePipeline::reset() {
+
+    for(std::unique_ptr<FrameStage>& stage : stages) {
+        stage->reset();
+    }
+
+}
+
+bool FramePipeline::process(BodyFrame& frame) {
+
+    for(size_t i = 0; i < stages.size(); i++) {
+
+        pipelineClock::time_point start = pipelineClock::now();
+        bool kept = stages[i]->process(frame);
+        statistics[i].seconds += std::chrono::duration<double>(pipelineClock::now() - start).count();
+        statistics[i].numFrames++;
+
+        if(!kept) {
+            statistics[i].numDropped++;
+            return false;
+        }
+
+    }
+    return true;
+
+}
+
+void FramePipeline::processClip(Clip& clip) {
+
+    for(size_t i = 0; i < stages.size(); i++) {
+        statistics[i].numFrames += clip.getNumFrames();
+        pipelineClock::time_point start = pipelineClock::now();
+        statistics[i].numDropped += stages[i]->processClip(clip);
+        statistics[i].seconds += std::chrono::duration<double>(pipelineClock::now() - start).count();
+    }
+    reset();
+
+}
+
+const std::vector<StageStatistics>& FramePipeline::getStatistics() const {
+    return statistics;
+}
+
+void FramePipeline::resetStatistics() {
+
+    for(StageStatistics& stage : statistics) {
+        stage.numFrames = 0;
+        stage.numDropped = 0;
+        stage.seconds = 0.0;
+    }
+
+}
+
+void FramePipeline::printStatistics(std::ostream& out) const {
+
+    for(const StageStatistics& stage : statistics) {
+        out << stage.name << ": " << stage.numFrames << " frames, " << stage.numDropped << " dropped, "
+            << (stage.numFrames > 0 ? stage.seconds / stage.numFrames * 1e6 : 0.0) << " us per frame" << std::endl;
+    }
+
+}
+
+FramePipeline loadPipeline(const std::string& fileName) {
+
+    FramePipeline pipeline;
+    std::ifstream fin(fileName);
+    if(!fin.is_open()) {
+        for(const char* name : DEFAULT_STAGES) {
+            pipeline.addStage(createStage(name, {}));
+        }
+        return pipeline;
+    }
+
+    std::string line;
+    while(std::getline(fin, line)) {
+
+        line = line.substr(0, line.find('#'));
+        std::stringstream s(line);
+        std::string name;
+        if(!(s >> name)) {
+            continue;
+        }
+
+        std::map<std::string, float> parameters;
+        std::string parameter;
+        while(s >> parameter) {
+            size_t separator = parameter.find('=');
+            try {
+                parameters[parameter.substr(0, separator)] = std::stof(parameter.substr(separator + 1));
+            } catch(std::exception&) {
+                std::cout << "ERROR::PIPELINE::BAD_PARAMETER " << parameter << " of " << name << std::endl;
+            }
+        }
+
+        std::unique_ptr<FrameStage> stage = createStage(name, parameters);
+        if(stage) {
+            pipeline.addStage(std::move(stage));
+        }
+        else {
+            std::cout << "ERROR::PIPELINE::UNKNOWN_STAGE " << name << std::endl;
+        }
+
+    }
+
+    return pipeline;
+
+}
@@ -0,0 +1,81 @@
+#ifndef INC_3D_AVATAR_FRAMEPIPELINE_H
+#define INC_3D_AVATAR_FRAMEPIPELINE_H
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Clip.h"
+
+// A step of the frame processing (a filter, a repair, a constraint...) working on a frame in place
+class FrameStage {
+
+public:
+
+    virtual ~FrameStage() = default;
+
+    // The name the stage has in the pipeline configuration
+    virtual const char* getName() const = 0;
+
+    // Forgets the frames seen so far
+    virtual void reset() {}
+
+    // Processes a live frame; false drops it, and the rest of the pipeline doesn't see it
+    virtual bool process(BodyFrame& frame) = 0;
+
+    // Processes a whole recording. By default its frames go through process() in order, from a reset stage, and the
+    // dropped ones are removed from the clip; stages that can look ahead do better here.
+    virtual int processClip(Clip& clip);
+
+};
+
+struct StageStatistics {
+    std::string name;
+    long numFrames;         // frames the stage processed
+    long numDropped;        // frames it dropped
+    double seconds;         // time spent in the stage
+};
+
+// An ordered list of stages: the same pipeline processes the recording on load and then the live frames
+class FramePipeline {
+
+private:
+
+    std::vector<std::unique_ptr<FrameStage>> stages;
+    std::vector<StageStatistics> statistics;
+
+public:
+
+    FramePipeline() = default;
+
+    void addStage(std::unique_ptr<FrameStage> stage);
+
+    int getNumStages() const;
+
+    // The first stage with that name, or nullptr
+    FrameStage* findStage(const std::string& name) const;
+
+    void reset();
+
+    // Runs a live frame through every stage, in order; false when a stage dropped it
+    bool process(BodyFrame& frame);
+
+    // Runs a recording through every stage, one stage at a time, then resets the stages for the live frames
+    void processClip(Clip& clip);
+
+    const std::vector<StageStatistics>& getStatistics() const;
+    void resetStatistics();
+
+    // One line per stage: frames, drops and mean time per frame
+    void printStatistics(std::ostream& out) const;
+
+};
+
+// Builds a pipeline from a configuration file: one stage per line, its name followed by name=value parameters, with
+// # starting a comment (see pipeline.cfg for the stages and their parameters). Without the file, the pipeline has the
+// default stages.
+FramePipeline loadPipeline(const std::string& fileName);
+
+
+#endif //INC_3D_AVATAR_FRAMEPIPELINE_H
@@ -0,0 +1,296 @@
+#include "FrameStages.h"
+
+#include <iostream>
+#include <set>
+
+#include "ThreadPool.h"
+#include "ZeroPhaseFilter.h"
+
+static float getParameter(const std::map<std::string, float>& parameters, const std::string& name, float value) {
+    auto parameter = parameters.find(name);
+    return parameter == parameters.end() ? value : parameter->second;
+}
+
+std::unique_ptr<FrameStage> createStage(const std::string& name, const std::map<std::string, float>& parameters) {
+
+    // the parameters the stage reads, so that the others (usually typos) are reported instead of ignored
+    std::set<std::string> known;
+    auto p = [&parameters, &known](const std::string& parameter, float value) {
+        known.insert(parameter);
+        return getParameter(parameters, parameter, value);
+    };
+    std::unique_ptr<FrameStage> stage;
+
+    if(name == "gapfill") {
+        GapFillSettings settings = {(int)p("maxGap", DEFAULT_GAP_FILL.maxGap),
+                                    (unsigned char)p("minState", DEFAULT_GAP_FILL.minState)};
+        stage.reset(new GapFillStage(settings));
+    }
+    else if(name == "outliers") {
+        OutlierSettings settings = {p("maxSpeed", DEFAULT_OUTLIER.maxSpeed),
+                                    p("maxHandSpeed", DEFAULT_OUTLIER.maxHandSpeed),
+                                    p("maxAcceleration", DEFAULT_OUTLIER.maxAcceleration),
+                                    p("maxBodyJump", DEFAULT_OUTLIER.maxBodyJump),
+                                    (int)p("maxRejectedFrames", DEFAULT_OUTLIER.maxRejectedFrames)};
+        stage.reset(new OutlierStage(settings));
+    }
+    else if(name == "oneeuro") {
+        OneEuroSettings torso = {p("minCutoff", DEFAULT_TORSO_ONE_EURO.minCutoff),
+                                 p("beta", DEFAULT_TORSO_ONE_EURO.beta),
+                                 p("derivativeCutoff", DEFAULT_TORSO_ONE_EURO.derivativeCutoff)};
+        OneEuroSettings hands = {p("handMinCutoff", DEFAULT_HAND_ONE_EURO.minCutoff),
+                                 p("handBeta", DEFAULT_HAND_ONE_EURO.beta),
+                                 p("handDerivativeCutoff", DEFAULT_HAND_ONE_EURO.derivativeCutoff)};
+        stage.reset(new OneEuroStage(torso, hands));
+    }
+    else if(name == "holt") {
+        HoltSettings settings = {p("smoothing", HOLT_SMOOTH.smoothing), p("correction", HOLT_SMOOTH.correction),
+                                 p("prediction", HOLT_SMOOTH.prediction), p("jitterRadius", HOLT_SMOOTH.jitterRadius),
+                                 p("maxDeviationRadius", HOLT_SMOOTH.maxDeviationRadius)};
+        stage.reset(new HoltStage(settings));
+    }
+    else if(name == "kalman") {
+        KalmanSettings settings = {p("measurementNoise", DEFAULT_KALMAN.measurementNoise),
+                                   p("inferredNoiseScale", DEFAULT_KALMAN.inferredNoiseScale),
+                                   p("accelerationNoise", DEFAULT_KALMAN.accelerationNoise)};
+        stage.reset(new KalmanStage(settings));
+    }
+    else if(name == "predict") {
+        PredictionSettings settings = {p("horizon", DEFAULT_PREDICTION.horizon),
+                                       p("maxSpeed", DEFAULT_PREDICTION.maxSpeed),
+                                       p("maxHandSpeed", DEFAULT_PREDICTION.maxHandSpeed),
+                                       p("maxAcceleration", DEFAULT_PREDICTION.maxAcceleration),
+                                       p("accelerationWeight", DEFAULT_PREDICTION.accelerationWeight)};
+        stage.reset(new PredictStage(settings));
+    }
+    else if(name == "bones") {
+        int calibrationFrames = (int)p("calibrationFrames", DEFAULT_CALIBRATION_FRAMES);
+        stage.reset(new BoneLengthStage(calibrationFrames));
+    }
+    else if(name == "floor") {
+        stage.reset(new FloorStage());
+    }
+    else if(name == "feet") {
+        FootContactSettings settings = {p("maxSpeed", DEFAULT_FOOT_CONTACT.maxSpeed),
+                                        p("maxHeight", DEFAULT_FOOT_CONTACT.maxHeight),
+                                        p("releaseTime", DEFAULT_FOOT_CONTACT.releaseTime)};
+        stage.reset(new FootContactStage(settings));
+    }
+    else if(name == "lowpass") {
+        stage.reset(new LowPassStage(p("cutoff", DEFAULT_SMOOTHING_CUTOFF)));
+    }
+
+    for(const auto& parameter : parameters) {
+        if(stage && !known.count(parameter.first)) {
+            std::cout << "ERROR::PIPELINE::UNKNOWN_PARAMETER " << parameter.first << " of " << name << std::endl;
+        }
+    }
+    return stage;
+
+}
+
+GapFillStage::GapFillStage(const GapFillSettings& settings) : filler(settings) {
+    this->settings = settings;
+}
+
+const char* GapFillStage::getName() const {
+    return "gapfill";
+}
+
+void GapFillStage::reset() {
+    filler.reset();
+}
+
+bool GapFillStage::process(BodyFrame& frame) {
+    filler.process(frame);
+    return true;
+}
+
+int GapFillStage::processClip(Clip& clip) {
+    fillGaps(clip, settings);
+    return 0;
+}
+
+OutlierStage::OutlierStage(const OutlierSettings& settings) : rejector(settings) {}
+
+const char* OutlierStage::getName() const {
+    return "outliers";
+}
+
+void OutlierStage::reset() {
+    rejector.reset();
+}
+
+bool OutlierStage::process(BodyFrame& frame) {
+    long rejectedFrames = rejector.getMetrics().rejectedFrames;
+    rejector.process(frame);
+    return rejector.getMetrics().rejectedFrames == rejectedFrames;
+}
+
+int OutlierStage::processClip(Clip&) {
+    return 0;
+}
+
+const OutlierRejector& OutlierStage::getRejector() const {
+    return rejector;
+}
+
+OneEuroStage::OneEuroStage(const OneEuroSettings& torso, const OneEuroSettings& hands) : filter(torso, hands) {}
+
+const char* OneEuroStage::getName() const {
+    return "oneeuro";
+}
+
+void OneEuroStage::reset() {
+    filter.reset();
+}
+
+bool OneEuroStage::process(BodyFrame& frame) {
+    filter.process(frame);
+    return true;
+}
+
+int OneEuroStage::processClip(Clip&) {
+    return 0;
+}
+
+HoltStage::HoltStage(const HoltSettings& settings) : smoother(settings) {}
+
+const char* HoltStage::getName() const {
+    return "holt";
+}
+
+void HoltStage::reset() {
+    smoother.reset();
+}
+
+bool HoltStage::process(BodyFrame& frame) {
+    smoother.process(frame);
+    return true;
+}
+
+int HoltStage::processClip(Clip&) {
+    return 0;
+}
+
+KalmanStage::KalmanStage(const KalmanSettings& settings) : bank(settings) {}
+
+const char* KalmanStage::getName() const {
+    return "kalman";
+}
+
+void KalmanStage::reset() {
+    bank.reset();
+}
+
+bool KalmanStage::process(BodyFrame& frame) {
+    bank.process(frame);
+    return true;
+}
+
+int KalmanStage::processClip(Clip&) {
+    return 0;
+}
+
+const float* KalmanStage::getVelocities() const {
+    return bank.getVelocities();
+}
+
+PredictStage::PredictStage(const PredictionSettings& settings) : predictor(settings) {}
+
+const char* PredictStage::getName() const {
+    return "predict";
+}
+
+void PredictStage::reset() {
+    predictor.reset();
+}
+
+bool PredictStage::process(BodyFrame& frame) {
+    predictor.process(frame);
+    return true;
+}
+
+int PredictStage::processClip(Clip&) {
+    return 0;
+}
+
+BoneLengthStage::BoneLengthStage(int calibrationFrames) : solver(calibrationFrames) {
+    this->calibrationFrames = calibrationFrames;
+}
+
+const char* BoneLengthStage::getName() const {
+    return "bones";
+}
+
+void BoneLengthStage::reset() {
+    solver.reset();
+}
+
+bool BoneLengthStage::process(BodyFrame& frame) {
+    solver.process(frame);
+    return true;
+}
+
+int BoneLengthStage::processClip(Clip& clip) {
+    constrainBoneLengths(clip, calibrationFrames);
+    return 0;
+}
+
+const char* FloorStage::getName() const {
+    return "floor";
+}
+
+void FloorStage::reset() {
+    aligner.reset();
+}
+
+bool FloorStage::process(BodyFrame& frame) {
+
+    // a frame without floor plane keeps the last one the sensor found
+    if(frame.floorPlane[1] > 0) {
+        aligner.setFloorPlane(frame.floorPlane);
+    }
+    aligner.observe(frame.positions, frame.time);
+    aligner.align(frame.positions);
+    return true;
+
+}
+
+int FloorStage::processClip(Clip& clip) {
+    alignClipToFloor(clip);
+    return 0;
+}
+
+FootContactStage::FootContactStage(const FootContactSettings& settings) : solver(settings) {}
+
+const char* FootContactStage::getName() const {
+    return "feet";
+}
+
+void FootContactStage::reset() {
+    solver.reset();
+}
+
+bool FootContactStage::process(BodyFrame& frame) {
+    solver.process(frame);
+    return true;
+}
+
+LowPassStage::LowPassStage(float cutoff) {
+    this->cutoff = cutoff;
+}
+
+const char* LowPassStage::getName() const {
+    return "lowpass";
+}
+
+bool LowPassStage::process(BodyFrame&) {
+    return true;
+}
+
+int LowPassStage::processClip(Clip& clip) {
+    ThreadPool pool;
+    filterClip(clip, cutoff, pool);
+    return 0;
+}
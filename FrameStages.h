@@ -0,0 +1,220 @@
+#ifndef INC_3D_AVATAR_FRAMESTAGES_H
+#define INC_3D_AVATAR_FRAMESTAGES_H
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "BoneLengthSolver.h"
+#include "FloorPlane.h"
+#include "FramePipeline.h"
+#include "GapFiller.h"
+#include "HoltSmoother.h"
+#include "KalmanFilterBank.h"
+#include "OneEuroFilter.h"
+#include "OutlierRejector.h"
+#include "PosePredictor.h"
+
+// The stages of a pipeline configuration file without any: repair, filter and constrain the frames
+const char* const DEFAULT_STAGES[] = {"gapfill", "outliers", "oneeuro", "bones", "floor", "feet"};
+
+// Creates the stage with that name from its parameters (those missing keep their defaults, those it doesn't have
+// are reported), or nullptr
+std::unique_ptr<FrameStage> createStage(const std::string& name, const std::map<std::string, float>& parameters);
+
+// gapfill: maxGap, minState
+class GapFillStage : public FrameStage {
+
+private:
+
+    GapFillSettings settings;
+    LiveGapFiller filler;
+
+public:
+
+    explicit GapFillStage(const GapFillSettings& settings);
+
+    const char* getName() const override;
+    void reset() override;
+    bool process(BodyFrame& frame) override;
+    // Rebuilds the gaps of a recording with splines through the samples on both sides
+    int processClip(Clip& clip) override;
+
+};
+
+// outliers: maxSpeed, maxHandSpeed, maxAcceleration, maxBodyJump, maxRejectedFrames. Frames where the whole body
+// jumped are dropped, rejected joints are replaced.
+class OutlierStage : public FrameStage {
+
+private:
+
+    OutlierRejector rejector;
+
+public:
+
+    explicit OutlierStage(const OutlierSettings& settings);
+
+    const char* getName() const override;
+    void reset() override;
+    bool process(BodyFrame& frame) override;
+    // Made for the Kinect noise of live frames: a recording is left as it is
+    int processClip(Clip& clip) override;
+
+    const OutlierRejector& getRejector() const;
+
+};
+
+// oneeuro: minCutoff, beta, derivativeCutoff for the torso, handMinCutoff, handBeta, handDerivativeCutoff for the hands
+class OneEuroStage : public FrameStage {
+
+private:
+
+    OneEuroFilter filter;
+
+public:
+
+    OneEuroStage(const OneEuroSettings& torso, const OneEuroSettings& hands);
+
+    const char* getName() const override;
+    void reset() override;
+    bool process(BodyFrame& frame) override;
+    // A causal filter lags behind a recording it could smooth both ways (see lowpass): it is left as it is
+    int processClip(Clip& clip) override;
+
+};
+
+// holt: smoothing, correction, prediction, jitterRadius, maxDeviationRadius (the "smooth" preset by default)
+class HoltStage : public FrameStage {
+
+private:
+
+    HoltSmoother smoother;
+
+public:
+
+    explicit HoltStage(const HoltSettings& settings);
+
+    const char* getName() const override;
+    void reset() override;
+    bool process(BodyFrame& frame) override;
+    // A causal filter lags behind a recording it could smooth both ways (see lowpass): it is left as it is
+    int processClip(Clip& clip) override;
+
+};
+
+// kalman: measurementNoise, inferredNoiseScale, accelerationNoise
+class KalmanStage : public FrameStage {
+
+private:
+
+    KalmanFilterBank bank;
+
+public:
+
+    explicit KalmanStage(const KalmanSettings& settings);
+
+    const char* getName() const override;
+    void reset() override;
+    bool process(BodyFrame& frame) override;
+    // A causal filter lags behind a recording it could smooth both ways (see lowpass): it is left as it is
+    int processClip(Clip& clip) override;
+
+    // The joint velocities of the last frame, in clip units per second
+    const float* getVelocities() const;
+
+};
+
+// predict: horizon, maxSpeed, maxHandSpeed, maxAcceleration, accelerationWeight
+class PredictStage : public FrameStage {
+
+private:
+
+    PosePredictor predictor;
+
+public:
+
+    explicit PredictStage(const PredictionSettings& settings);
+
+    const char* getName() const override;
+    void reset() override;
+    bool process(BodyFrame& frame) override;
+    // A recording has no latency to make up for: it is left as it is
+    int processClip(Clip& clip) override;
+
+};
+
+// bones: calibrationFrames
+class BoneLengthStage : public FrameStage {
+
+private:
+
+    int calibrationFrames;
+    BoneLengthSolver solver;
+
+public:
+
+    explicit BoneLengthStage(int calibrationFrames);
+
+    const char* getName() const override;
+    void reset() override;
+    bool process(BodyFrame& frame) override;
+    // Calibrates on the start of the recording, then solves all of it
+    int processClip(Clip& clip) override;
+
+};
+
+// floor: no parameters
+class FloorStage : public FrameStage {
+
+private:
+
+    FloorAligner aligner;
+
+public:
+
+    FloorStage() = default;
+
+    const char* getName() const override;
+    void reset() override;
+    bool process(BodyFrame& frame) override;
+    // Estimates the floor from all the feet of the recording when it has no floor plane
+    int processClip(Clip& clip) override;
+
+};
+
+// feet: maxSpeed, maxHeight, releaseTime
+class FootContactStage : public FrameStage {
+
+private:
+
+    FootContactSolver solver;
+
+public:
+
+    explicit FootContactStage(const FootContactSettings& settings);
+
+    const char* getName() const override;
+    void reset() override;
+    bool process(BodyFrame& frame) override;
+
+};
+
+// lowpass: cutoff. Zero-phase smoothing needs the frames to come, so it only smooths recordings.
+class LowPassStage : public FrameStage {
+
+private:
+
+    float cutoff;
+
+public:
+
+    explicit LowPassStage(float cutoff);
+
+    const char* getName() const override;
+    bool process(BodyFrame& frame) override;
+    int processClip(Clip& clip) override;
+
+};
+
+
+#endif //INC_3D_AVATAR_FRAMESTAGES_H
@@ -0,0 +1,198 @@
+#include "GapFiller.h"
+
+#include <algorithm>
+#include <vector>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define GAP_FILL_SSE
+#endif
+
+const int GAP_FILL_LANES = (NUM_CHANNELS + 3) / 4 * 4;
+
+int fillGaps(Clip& clip, const GapFillSettings& settings) {
+
+    int numFrames = clip.getNumFrames();
+    int numFilled = 0;
+
+    // the good/bad mask of the whole clip is computed in one pass first
+    std::vector<unsigned char> good(numFrames * NUM_JOINTS);
+    for(int f = 0; f < numFrames; f++) {
+        const unsigned char* states = clip.getTrackingStates(f);
+        for(int j = 0; j < NUM_JOINTS; j++) {
+            good[f * NUM_JOINTS + j] = states[j] >= settings.minState;
+        }
+    }
+
+    // then, for every frame and joint, the good frames around it: the last one at or before it (-1 when none) and
+    // the first one at or after it (numFrames when none), in a forward and a backward pass over the whole clip
+    std::vector<int> before(numFrames * NUM_JOINTS);
+    std::vector<int> after(numFrames * NUM_JOINTS);
+    for(int f = 0; f < numFrames; f++) {
+        for(int j = 0; j < NUM_JOINTS; j++) {
+            int i = f * NUM_JOINTS + j;
+            before[i] = good[i] ? f : (f > 0 ? before[i - NUM_JOINTS] : -1);
+        }
+    }
+    for(int f = numFrames - 1; f >= 0; f--) {
+        for(int j = 0; j < NUM_JOINTS; j++) {
+            int i = f * NUM_JOINTS + j;
+            after[i] = good[i] ? f : (f < numFrames - 1 ? after[i + NUM_JOINTS] : numFrames);
+        }
+    }
+
+    // Every frame is rebuilt in one sweep over its 75 channels: p = h00 p0 + h10 m0 + h01 p1 + h11 m1, with the
+    // Hermite weights of each joint repeated over its three channels, and only the filled channels written back
+    alignas(16) float x[GAP_FILL_LANES] = {};
+    alignas(16) float h00[GAP_FILL_LANES] = {};
+    alignas(16) float h10[GAP_FILL_LANES] = {};
+    alignas(16) float h01[GAP_FILL_LANES] = {};
+    alignas(16) float h11[GAP_FILL_LANES] = {};
+    alignas(16) float p0[GAP_FILL_LANES] = {};
+    alignas(16) float p1[GAP_FILL_LANES] = {};
+    alignas(16) float m0[GAP_FILL_LANES] = {};
+    alignas(16) float m1[GAP_FILL_LANES] = {};
+    alignas(16) float filled[GAP_FILL_LANES] = {};
+
+    for(int f = 0; f < numFrames; f++) {
+
+        bool anyFilled = false;
+        for(int j = 0; j < NUM_JOINTS; j++) {
+
+            int i = f * NUM_JOINTS + j;
+            int first = before[i];
+            int last = after[i];
+            std::fill(filled + 3 * j, filled + 3 * j + 3, 0.0f);
+            if(good[i] || last - first - 1 > settings.maxGap || (first < 0 && last >= numFrames)) {
+                continue;
+            }
+            anyFilled = true;
+            numFilled++;
+            std::fill(filled + 3 * j, filled + 3 * j + 3, 1.0f);
+
+            // at the ends of the clip there is only one good side: hold it
+            float w00 = 1.0f, w10 = 0.0f, w01 = 0.0f, w11 = 0.0f;
+            const float* q0 = clip.getFrame(first < 0 ? last : first) + 3 * j;
+            const float* q1 = q0;
+            float t0[3] = {}, t1[3] = {};
+
+            if(first >= 0 && last < numFrames) {
+                // outer neighbours for the tangents, when they are good as well
+                int firstOuter = first > 0 && good[i - (f - first + 1) * NUM_JOINTS] ? first - 1 : first;
+                int lastOuter = last + 1 < numFrames && good[i + (last - f + 1) * NUM_JOINTS] ? last + 1 : last;
+
+                float time0 = clip.getTime(first);
+                float time1 = clip.getTime(last);
+                float span = time1 - time0;
+                q1 = clip.getFrame(last) + 3 * j;
+                const float* outer0 = clip.getFrame(firstOuter) + 3 * j;
+                const float* outer1 = clip.getFrame(lastOuter) + 3 * j;
+                // tangents over the whole span, i.e. already multiplied by its length
+                float scale0 = span / (time1 - clip.getTime(firstOuter));
+                float scale1 = span / (clip.getTime(lastOuter) - time0);
+                for(int c = 0; c < 3; c++) {
+                    t0[c] = (q1[c] - outer0[c]) * scale0;
+                    t1[c] = (outer1[c] - q0[c]) * scale1;
+                }
+
+                float u = (clip.getTime(f) - time0) / span;
+                float u2 = u * u;
+                float u3 = u2 * u;
+                w00 = 2 * u3 - 3 * u2 + 1;
+                w10 = u3 - 2 * u2 + u;
+                w01 = 3 * u2 - 2 * u3;
+                w11 = u3 - u2;
+            }
+
+            for(int c = 0; c < 3; c++) {
+                h00[3 * j + c] = w00;
+                h10[3 * j + c] = w10;
+                h01[3 * j + c] = w01;
+                h11[3 * j + c] = w11;
+                p0[3 * j + c] = q0[c];
+                p1[3 * j + c] = q1[c];
+                m0[3 * j + c] = t0[c];
+                m1[3 * j + c] = t1[c];
+            }
+
+        }
+
+        if(!anyFilled) {
+            continue;
+        }
+
+        float* frame = clip.getFrame(f);
+        std::copy(frame, frame + NUM_CHANNELS, x);
+
+#ifdef GAP_FILL_SSE
+        for(int c = 0; c < GAP_FILL_LANES; c += 4) {
+            __m128 p = _mm_mul_ps(_mm_load_ps(h00 + c), _mm_load_ps(p0 + c));
+            p = _mm_add_ps(p, _mm_mul_ps(_mm_load_ps(h10 + c), _mm_load_ps(m0 + c)));
+            p = _mm_add_ps(p, _mm_mul_ps(_mm_load_ps(h01 + c), _mm_load_ps(p1 + c)));
+            p = _mm_add_ps(p, _mm_mul_ps(_mm_load_ps(h11 + c), _mm_load_ps(m1 + c)));
+            __m128 mask = _mm_cmpneq_ps(_mm_load_ps(filled + c), _mm_setzero_ps());
+            _mm_store_ps(x + c, _mm_or_ps(_mm_and_ps(mask, p), _mm_andnot_ps(mask, _mm_load_ps(x + c))));
+        }
+#else
+        for(int c = 0; c < GAP_FILL_LANES; c++) {
+            if(filled[c] != 0.0f) {
+                x[c] = h00[c] * p0[c] + h10[c] * m0[c] + h01[c] * p1[c] + h11[c] * m1[c];
+            }
+        }
+#endif
+
+        std::copy(x, x + NUM_CHANNELS, frame);
+
+    }
+
+    return numFilled;
+
+}
+
+LiveGapFiller::LiveGapFiller(const GapFillSettings& settings) {
+
+    this->settings = settings;
+    reset();
+
+}
+
+void LiveGapFiller::reset() {
+
+    std::fill(numGood, numGood + NUM_JOINTS, 0);
+    std::fill(badFrames, badFrames + NUM_JOINTS, 0);
+
+}
+
+void LiveGapFiller::process(BodyFrame& frame) {
+
+    for(int j = 0; j < NUM_JOINTS; j++) {
+
+        float* p = frame.positions + 3 * j;
+
+        if(frame.trackingStates[j] >= settings.minState) {
+            std::copy(lastGood + 3 * j, lastGood + 3 * j + 3, previousGood + 3 * j);
+            std::copy(p, p + 3, lastGood + 3 * j);
+            previousGoodTime[j] = lastGoodTime[j];
+            lastGoodTime[j] = frame.time;
+            numGood[j] = std::min(numGood[j] + 1, 2);
+            badFrames[j] = 0;
+            continue;
+        }
+
+        badFrames[j]++;
+        if(numGood[j] == 0 || badFrames[j] > settings.maxGap) {
+            continue;
+        }
+
+        // constant velocity from the two last good samples, or hold the last one
+        float velocityScale = 0.0f;
+        if(numGood[j] == 2 && lastGoodTime[j] > previousGoodTime[j]) {
+            velocityScale = (float)((frame.time - lastGoodTime[j]) / (lastGoodTime[j] - previousGoodTime[j]));
+        }
+        for(int c = 3 * j; c < 3 * j + 3; c++) {
+            frame.positions[c] = lastGood[c] + (lastGood[c] - previousGood[c]) * velocityScale;
+        }
+
+    }
+
+}
@@ -0,0 +1,47 @@
+#ifndef INC_3D_AVATAR_GAPFILLER_H
+#define INC_3D_AVATAR_GAPFILLER_H
+
+#include "Clip.h"
+
+struct GapFillSettings {
+    int maxGap;                 // longest span of bad samples that is rebuilt, in frames
+    unsigned char minState;     // joints tracked worse than this are bad: TRACKED also repairs the inferred ones
+};
+
+// Kinect runs at 30 Hz, so half a second of occlusion at most
+const GapFillSettings DEFAULT_GAP_FILL = {15, TRACKED};
+
+// Rebuilds the spans where a joint is inferred or not tracked, with a cubic Hermite spline through the good samples
+// around them (Catmull-Rom tangents, using the key times). Spans longer than maxGap are left alone, spans at the
+// ends of the clip hold the nearest good sample. Returns the number of joint samples rebuilt.
+int fillGaps(Clip& clip, const GapFillSettings& settings = DEFAULT_GAP_FILL);
+
+// The same repair for live data, where the samples after a gap are not known yet: a bad joint is extrapolated from
+// the last two good samples of a small look-behind window, for at most maxGap frames.
+class LiveGapFiller {
+
+private:
+
+    GapFillSettings settings;
+
+    // look-behind window: the last two good samples of every joint, and their times
+    float lastGood[NUM_CHANNELS];
+    float previousGood[NUM_CHANNELS];
+    double lastGoodTime[NUM_JOINTS];
+    double previousGoodTime[NUM_JOINTS];
+    int numGood[NUM_JOINTS];
+    int badFrames[NUM_JOINTS];
+
+public:
+
+    explicit LiveGapFiller(const GapFillSettings& settings = DEFAULT_GAP_FILL);
+
+    void reset();
+
+    // Repairs the bad joints of a new frame in place
+    void process(BodyFrame& frame);
+
+};
+
+
+#endif //INC_3D_AVATAR_GAPFILLER_H
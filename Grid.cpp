@@ -0,0 +1,57 @@
+#include "Grid.h"
+
+#include <cmath>
+#include <vector>
+
+Grid::Grid(const glm::vec3& corner, float extent, float spacing, const glm::vec3& color) {
+
+    // one line along z and one along x at every step, each vertex being a position and a colour
+    int numSteps = (int)std::round(extent / spacing);
+    std::vector<float> vertices;
+    for(int step = 0; step <= numSteps; step++) {
+        float offset = step * spacing;
+        float lines[4][3] = {{corner.x + offset, corner.y, corner.z}, {corner.x + offset, corner.y, corner.z + extent},
+                             {corner.x, corner.y, corner.z + offset}, {corner.x + extent, corner.y, corner.z + offset}};
+        for(const float* position : lines) {
+            vertices.insert(vertices.end(), {position[0], position[1], position[2], color.x, color.y, color.z});
+        }
+    }
+    numVertices = (int)vertices.size() / 6;
+
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+
+    glGenBuffers(1, &VBO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+
+    // position
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), nullptr);
+    glEnableVertexAttribArray(0);
+
+    // color
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    glBindVertexArray(0);
+
+}
+
+Grid::~Grid() {
+
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+
+}
+
+void Grid::draw(Shader* shader) const {
+
+    shader->use();
+    shader->setMat4("model", glm::mat4(1.0f));
+
+    glLineWidth(3.0f);
+    glBindVertexArray(VAO);
+    glDrawArrays(GL_LINES, 0, numVertices);
+    glBindVertexArray(0);
+
+}
@@ -0,0 +1,34 @@
+#ifndef INC_3D_AVATAR_GRID_H
+#define INC_3D_AVATAR_GRID_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "Shader.h"
+
+// The ground grid: a square of lines on the y = 0 plane, built once into a static line list and drawn in one call
+class Grid {
+
+private:
+
+    unsigned int VAO, VBO;
+    int numVertices;
+
+public:
+
+    // A grid from corner to corner + (extent, 0, extent), with a line every spacing
+    Grid(const glm::vec3& corner, float extent, float spacing, const glm::vec3& color = glm::vec3(1.0f));
+
+    ~Grid();
+
+    Grid(const Grid&) = delete;
+
+    Grid& operator=(const Grid&) = delete;
+
+    // Draws the grid with a shader taking the vertexShader.vert inputs, with the camera of the frame
+    void draw(Shader* shader) const;
+
+};
+
+
+#endif //INC_3D_AVATAR_GRID_H
@@ -0,0 +1,133 @@
+#include "HoltSmoother.h"
+
+#include <algorithm>
+#include <cmath>
+
+HoltSmoother::HoltSmoother(const HoltSettings& settings) {
+
+    this->settings = settings;
+    reset();
+
+}
+
+const HoltSettings& HoltSmoother::getSettings() const {
+    return settings;
+}
+
+void HoltSmoother::setSettings(const HoltSettings& settings) {
+    HoltSmoother::settings = settings;
+}
+
+void HoltSmoother::reset() {
+
+    std::fill(rawPositions, rawPositions + NUM_CHANNELS, 0.0f);
+    std::fill(filteredPositions, filteredPositions + NUM_CHANNELS, 0.0f);
+    std::fill(trends, trends + NUM_CHANNELS, 0.0f);
+    std::fill(frameCounts, frameCounts + NUM_JOINTS, 0);
+
+}
+
+static float length(const float* v) {
+    return std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+}
+
+void HoltSmoother::smooth(float* positions, const unsigned char* trackingStates, int numFrames) {
+
+    float smoothing = settings.smoothing;
+    float correction = settings.correction;
+    float prediction = settings.prediction;
+
+    for(int i = 0; i < numFrames; i++) {
+
+        float* frame = positions + i * NUM_CHANNELS;
+        const unsigned char* states = trackingStates + i * NUM_JOINTS;
+
+        for(int j = 0; j < NUM_JOINTS; j++) {
+
+            float* p = frame + 3 * j;
+            float* raw = rawPositions + 3 * j;
+            float* filtered = filteredPositions + 3 * j;
+            float* trend = trends + 3 * j;
+
+            if(states[j] == NOT_TRACKED) {
+                frameCounts[j] = 0;
+                continue;
+            }
+
+            // the radii are in metres, the positions in clip units
+            float radiusScale = states[j] == INFERRED ? 2 * CLIP_SCALE : CLIP_SCALE;
+            float jitterRadius = settings.jitterRadius * radiusScale;
+            float maxDeviationRadius = settings.maxDeviationRadius * radiusScale;
+
+            float input[3] = {p[0], p[1], p[2]};
+            float newFiltered[3];
+            float newTrend[3];
+
+            if(frameCounts[j] == 0) {
+                std::copy(input, input + 3, newFiltered);
+                std::fill(newTrend, newTrend + 3, 0.0f);
+            }
+            else if(frameCounts[j] == 1) {
+                for(int c = 0; c < 3; c++) {
+                    newFiltered[c] = (input[c] + raw[c]) / 2;
+                    newTrend[c] = (newFiltered[c] - filtered[c]) * correction + trend[c] * (1 - correction);
+                }
+            }
+            else {
+                // damp the moves that stay within the jitter radius of the last smoothed position
+                float difference[3] = {input[0] - filtered[0], input[1] - filtered[1], input[2] - filtered[2]};
+                float distance = length(difference);
+                float damped[3];
+                for(int c = 0; c < 3; c++) {
+                    damped[c] = distance <= jitterRadius ?
+                                input[c] * (distance / jitterRadius) + filtered[c] * (1 - distance / jitterRadius) :
+                                input[c];
+                }
+                for(int c = 0; c < 3; c++) {
+                    newFiltered[c] = damped[c] * (1 - smoothing) + (filtered[c] + trend[c]) * smoothing;
+                    newTrend[c] = (newFiltered[c] - filtered[c]) * correction + trend[c] * (1 - correction);
+                }
+            }
+
+            // predict ahead, without straying farther than the max deviation radius from the raw data
+            float predicted[3];
+            for(int c = 0; c < 3; c++) {
+                predicted[c] = newFiltered[c] + newTrend[c] * prediction;
+            }
+            float deviation[3] = {predicted[0] - input[0], predicted[1] - input[1], predicted[2] - input[2]};
+            float distance = length(deviation);
+            if(distance > maxDeviationRadius) {
+                for(int c = 0; c < 3; c++) {
+                    predicted[c] = predicted[c] * (maxDeviationRadius / distance) +
+                                   input[c] * (1 - maxDeviationRadius / distance);
+                }
+            }
+
+            std::copy(input, input + 3, raw);
+            std::copy(newFiltered, newFiltered + 3, filtered);
+            std::copy(newTrend, newTrend + 3, trend);
+            frameCounts[j] = std::min(frameCounts[j] + 1, 2);
+            std::copy(predicted, predicted + 3, p);
+
+        }
+
+    }
+
+}
+
+void HoltSmoother::process(BodyFrame& frame) {
+
+    smooth(frame.positions, frame.trackingStates, 1);
+
+}
+
+void smoothClip(Clip& clip, const HoltSettings& settings) {
+
+    if(clip.getNumFrames() == 0) {
+        return;
+    }
+
+    HoltSmoother smoother(settings);
+    smoother.smooth(clip.getFrame(0), clip.getTrackingStates(0), clip.getNumFrames());
+
+}
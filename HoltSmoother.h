@@ -0,0 +1,54 @@
+#ifndef INC_3D_AVATAR_HOLTSMOOTHER_H
+#define INC_3D_AVATAR_HOLTSMOOTHER_H
+
+#include "Clip.h"
+
+// The smoothing parameters of the Kinect SDK (NUI_TRANSFORM_SMOOTH_PARAMETERS), with the radii in metres
+struct HoltSettings {
+    float smoothing;            // 0 returns the raw data, towards 1 smooths more and lags more
+    float correction;           // how fast the trend follows the data: towards 1 corrects faster
+    float prediction;           // number of frames predicted into the future
+    float jitterRadius;         // moves shorter than this are damped as jitter
+    float maxDeviationRadius;   // the farthest the output may stray from the raw data
+};
+
+// The SDK documentation's presets: "smooth" (some smoothing with little latency) and "very smooth"
+const HoltSettings HOLT_SMOOTH = {0.5f, 0.1f, 0.5f, 0.1f, 0.1f};
+const HoltSettings HOLT_VERY_SMOOTH = {0.7f, 0.3f, 1.0f, 1.0f, 1.0f};
+
+// Holt double exponential smoothing of every joint, as the Kinect SDK filtered its skeletons: a smoothed position
+// and a trend per joint, with jitter damping, prediction and a clamp to the raw data. Joints that are not tracked
+// restart their filter, inferred joints get twice the radii.
+class HoltSmoother {
+
+private:
+
+    HoltSettings settings;
+
+    float rawPositions[NUM_CHANNELS];
+    float filteredPositions[NUM_CHANNELS];
+    float trends[NUM_CHANNELS];
+    int frameCounts[NUM_JOINTS];
+
+public:
+
+    explicit HoltSmoother(const HoltSettings& settings = HOLT_SMOOTH);
+
+    const HoltSettings& getSettings() const;
+    void setSettings(const HoltSettings& settings);
+
+    void reset();
+
+    // Smooths numFrames consecutive frames of a frame-major buffer in place (75 positions and 25 tracking states per
+    // frame), continuing from the frames smoothed before
+    void smooth(float* positions, const unsigned char* trackingStates, int numFrames);
+
+    void process(BodyFrame& frame);
+
+};
+
+// Smooths a whole recording, from its first frame
+void smoothClip(Clip& clip, const HoltSettings& settings = HOLT_SMOOTH);
+
+
+#endif //INC_3D_AVATAR_HOLTSMOOTHER_H
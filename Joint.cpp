@@ -28,8 +28,9 @@ void Joint::setX(float x) {
     Joint::x = x;
 }
 
+// The poses are floor-aligned, so the floor is already at y = 0: x and z only move the avatar to the middle of the grid
 std::vector<float> Joint::getCoordinates() {
-    return {this->x + 6, this->y + (float)2.5, this->z + 2};
+    return {this->x + 6, this->y, this->z + 2};
 }
 
 
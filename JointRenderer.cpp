@@ -0,0 +1,94 @@
+#include "JointRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+const float SPHERE_PI = 3.14159265f;
+
+JointRenderer::JointRenderer(int maxInstances, int slices, int stacks)
+        : shader("../Shaders/jointVertShader.vert", "../Shaders/fragmentShader.frag"),
+          instanceBuffer(maxInstances * sizeof(JointInstance)) {
+
+    this->maxInstances = maxInstances;
+    modelUniform = shader.getUniform("model");
+
+    // a unit sphere, one ring of vertices per stack from the north pole down (the seam and the poles are duplicated)
+    std::vector<float> vertices;
+    for(int stack = 0; stack <= stacks; stack++) {
+        float phi = SPHERE_PI * stack / stacks;
+        for(int slice = 0; slice <= slices; slice++) {
+            float theta = 2 * SPHERE_PI * slice / slices;
+            vertices.push_back(std::sin(phi) * std::cos(theta));
+            vertices.push_back(std::cos(phi));
+            vertices.push_back(std::sin(phi) * std::sin(theta));
+        }
+    }
+
+    std::vector<unsigned int> indices;
+    for(int stack = 0; stack < stacks; stack++) {
+        for(int slice = 0; slice < slices; slice++) {
+            unsigned int top = stack * (slices + 1) + slice;
+            unsigned int bottom = top + slices + 1;
+            indices.insert(indices.end(), {top, bottom, top + 1, top + 1, bottom, bottom + 1});
+        }
+    }
+    numIndices = (int)indices.size();
+
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+
+    glGenBuffers(1, &meshVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, meshVBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+
+    glGenBuffers(1, &meshEBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshEBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+
+    // position on the unit sphere
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
+    glEnableVertexAttribArray(0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer.getBuffer());
+
+    // centre and radius, then colour, once per instance
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(JointInstance), nullptr);
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(JointInstance), (void*)(4 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+
+    glBindVertexArray(0);
+
+}
+
+JointRenderer::~JointRenderer() {
+
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &meshVBO);
+    glDeleteBuffers(1, &meshEBO);
+
+}
+
+void JointRenderer::draw(const JointInstance* instances, int numInstances, const glm::mat4& model) {
+
+    numInstances = std::min(numInstances, maxInstances);
+
+    // the instances go straight into the mapped region, which the draw picks through its base instance
+    std::copy(instances, instances + numInstances, (JointInstance*)instanceBuffer.begin());
+    GLuint baseInstance = instanceBuffer.getOffset() / sizeof(JointInstance);
+
+    shader.use();
+    shader.setMat4(modelUniform, model);
+
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    glBindVertexArray(VAO);
+    glDrawElementsInstancedBaseInstance(GL_TRIANGLES, numIndices, GL_UNSIGNED_INT, nullptr, numInstances,
+                                        baseInstance);
+    glBindVertexArray(0);
+    instanceBuffer.end();
+
+}
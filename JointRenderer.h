@@ -0,0 +1,46 @@
+#ifndef INC_3D_AVATAR_JOINTRENDERER_H
+#define INC_3D_AVATAR_JOINTRENDERER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "Shader.h"
+#include "StreamingBuffer.h"
+
+// One joint sphere: its centre, radius and colour, as the instance buffer stores it
+struct JointInstance {
+    float position[3];
+    float radius;
+    float color[3];
+};
+
+// Draws the joint spheres of the skeletons in a single instanced draw call: the unit sphere mesh is built once, and
+// every sphere only adds an instance to the streaming buffer written each frame
+class JointRenderer {
+
+private:
+
+    Shader shader;
+    UniformHandle modelUniform;
+    unsigned int VAO, meshVBO, meshEBO;
+    StreamingBuffer instanceBuffer;
+    int numIndices;
+    int maxInstances;
+
+public:
+
+    explicit JointRenderer(int maxInstances, int slices = 32, int stacks = 16);
+
+    ~JointRenderer();
+
+    JointRenderer(const JointRenderer&) = delete;
+
+    JointRenderer& operator=(const JointRenderer&) = delete;
+
+    // Draws numInstances spheres (at most maxInstances), moved by the model matrix, with the camera of the frame
+    void draw(const JointInstance* instances, int numInstances, const glm::mat4& model);
+
+};
+
+
+#endif //INC_3D_AVATAR_JOINTRENDERER_H
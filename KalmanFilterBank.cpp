@@ -0,0 +1,153 @@
+#include "KalmanFilterBank.h"
+
+#include <algorithm>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define KALMAN_SSE
+#endif
+
+// variance of a fresh filter's velocity: about a metre per second
+const float INITIAL_VELOCITY_VARIANCE = CLIP_SCALE * CLIP_SCALE;
+
+KalmanFilterBank::KalmanFilterBank(const KalmanSettings& settings) {
+
+    this->settings = settings;
+    reset();
+
+}
+
+const KalmanSettings& KalmanFilterBank::getSettings() const {
+    return settings;
+}
+
+void KalmanFilterBank::setSettings(const KalmanSettings& settings) {
+    KalmanFilterBank::settings = settings;
+}
+
+void KalmanFilterBank::reset() {
+
+    std::fill(positions, positions + KALMAN_LANES, 0.0f);
+    std::fill(velocities, velocities + KALMAN_LANES, 0.0f);
+    std::fill(p00, p00 + KALMAN_LANES, 0.0f);
+    std::fill(p01, p01 + KALMAN_LANES, 0.0f);
+    std::fill(p11, p11 + KALMAN_LANES, 0.0f);
+    std::fill(noise, noise + KALMAN_LANES, 0.0f);
+    std::fill(measured, measured + KALMAN_LANES, 0.0f);
+    lastTime = 0.0;
+    initialized = false;
+
+}
+
+void KalmanFilterBank::update(const float* measurements, const unsigned char* trackingStates, double time) {
+
+    float trackedVariance = CLIP_SCALE * settings.measurementNoise * CLIP_SCALE * settings.measurementNoise;
+    float inferredVariance = trackedVariance * settings.inferredNoiseScale * settings.inferredNoiseScale;
+
+    // the measurement noise follows the tracking state, and a gain of 0 skips the joints that are not tracked
+    for(int j = 0; j < NUM_JOINTS; j++) {
+        float variance = trackingStates[j] == TRACKED ? trackedVariance : inferredVariance;
+        float gainMask = trackingStates[j] == NOT_TRACKED ? 0.0f : 1.0f;
+        for(int c = 3 * j; c < 3 * j + 3; c++) {
+            noise[c] = variance;
+            measured[c] = gainMask;
+        }
+    }
+
+    if(!initialized || time <= lastTime) {
+        // start every filter at its measurement, at rest
+        std::copy(measurements, measurements + NUM_CHANNELS, positions);
+        std::fill(velocities, velocities + KALMAN_LANES, 0.0f);
+        std::copy(noise, noise + KALMAN_LANES, p00);
+        std::fill(p01, p01 + KALMAN_LANES, 0.0f);
+        std::fill(p11, p11 + KALMAN_LANES, INITIAL_VELOCITY_VARIANCE);
+        lastTime = time;
+        initialized = true;
+        return;
+    }
+
+    float dt = (float)(time - lastTime);
+    lastTime = time;
+
+    // process noise of a white acceleration over dt
+    float q = CLIP_SCALE * settings.accelerationNoise * CLIP_SCALE * settings.accelerationNoise;
+    float q00 = q * dt * dt * dt * dt / 4;
+    float q01 = q * dt * dt * dt / 2;
+    float q11 = q * dt * dt;
+
+    alignas(16) float z[KALMAN_LANES] = {};
+    std::copy(measurements, measurements + NUM_CHANNELS, z);
+
+#ifdef KALMAN_SSE
+    __m128 step = _mm_set1_ps(dt);
+    __m128 one = _mm_set1_ps(1.0f);
+
+    for(int c = 0; c < KALMAN_LANES; c += 4) {
+
+        // predict: x += v dt, P = F P F' + Q
+        __m128 x = _mm_load_ps(positions + c);
+        __m128 v = _mm_load_ps(velocities + c);
+        __m128 a = _mm_load_ps(p00 + c);
+        __m128 b = _mm_load_ps(p01 + c);
+        __m128 d = _mm_load_ps(p11 + c);
+
+        x = _mm_add_ps(x, _mm_mul_ps(v, step));
+        __m128 bd = _mm_add_ps(b, _mm_mul_ps(d, step));
+        a = _mm_add_ps(_mm_add_ps(a, _mm_mul_ps(step, _mm_add_ps(b, bd))), _mm_set1_ps(q00));
+        b = _mm_add_ps(bd, _mm_set1_ps(q01));
+        d = _mm_add_ps(d, _mm_set1_ps(q11));
+
+        // correct: K = P H' / (H P H' + R), masked to 0 where nothing was measured
+        __m128 mask = _mm_load_ps(measured + c);
+        __m128 inverse = _mm_div_ps(mask, _mm_add_ps(a, _mm_add_ps(_mm_load_ps(noise + c), _mm_sub_ps(one, mask))));
+        __m128 k0 = _mm_mul_ps(a, inverse);
+        __m128 k1 = _mm_mul_ps(b, inverse);
+        __m128 innovation = _mm_sub_ps(_mm_load_ps(z + c), x);
+
+        _mm_store_ps(positions + c, _mm_add_ps(x, _mm_mul_ps(k0, innovation)));
+        _mm_store_ps(velocities + c, _mm_add_ps(v, _mm_mul_ps(k1, innovation)));
+        _mm_store_ps(p11 + c, _mm_sub_ps(d, _mm_mul_ps(k1, b)));
+        __m128 keep = _mm_sub_ps(one, k0);
+        _mm_store_ps(p00 + c, _mm_mul_ps(keep, a));
+        _mm_store_ps(p01 + c, _mm_mul_ps(keep, b));
+
+    }
+#else
+    for(int c = 0; c < KALMAN_LANES; c++) {
+
+        float x = positions[c] + velocities[c] * dt;
+        float bd = p01[c] + p11[c] * dt;
+        float a = p00[c] + dt * (p01[c] + bd) + q00;
+        float b = bd + q01;
+        float d = p11[c] + q11;
+
+        float inverse = measured[c] / (a + noise[c] + 1 - measured[c]);
+        float k0 = a * inverse;
+        float k1 = b * inverse;
+        float innovation = z[c] - x;
+
+        positions[c] = x + k0 * innovation;
+        velocities[c] += k1 * innovation;
+        p11[c] = d - k1 * b;
+        p00[c] = (1 - k0) * a;
+        p01[c] = (1 - k0) * b;
+
+    }
+#endif
+
+}
+
+const float* KalmanFilterBank::getPositions() const {
+    return positions;
+}
+
+const float* KalmanFilterBank::getVelocities() const {
+    return velocities;
+}
+
+void KalmanFilterBank::process(BodyFrame& frame) {
+
+    update(frame.positions, frame.trackingStates, frame.time);
+    std::copy(positions, positions + NUM_CHANNELS, frame.positions);
+
+}
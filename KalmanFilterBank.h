@@ -0,0 +1,61 @@
+#ifndef INC_3D_AVATAR_KALMANFILTERBANK_H
+#define INC_3D_AVATAR_KALMANFILTERBANK_H
+
+#include "Clip.h"
+
+// 75 channels padded to a whole number of 4-float SIMD lanes
+const int KALMAN_LANES = (NUM_CHANNELS + 3) / 4 * 4;
+
+struct KalmanSettings {
+    float measurementNoise;     // standard deviation of a tracked joint, in metres
+    float inferredNoiseScale;   // how much noisier an inferred joint is than a tracked one
+    float accelerationNoise;    // standard deviation of the unmodelled acceleration, in metres per second squared
+};
+
+// Kinect v2 joints are accurate to about a centimetre when tracked, and guessed when inferred
+const KalmanSettings DEFAULT_KALMAN = {0.01f, 5.0f, 5.0f};
+
+// A bank of 75 independent constant velocity Kalman filters, one per channel, with the state (position and
+// velocity) and the 2x2 covariance of every filter stored as separate arrays and updated four channels at a time.
+// The measurement noise of a joint follows its tracking state: untracked joints are only predicted.
+class KalmanFilterBank {
+
+private:
+
+    KalmanSettings settings;
+
+    alignas(16) float positions[KALMAN_LANES];
+    alignas(16) float velocities[KALMAN_LANES];
+    // the symmetric covariance: position variance, position-velocity covariance, velocity variance
+    alignas(16) float p00[KALMAN_LANES];
+    alignas(16) float p01[KALMAN_LANES];
+    alignas(16) float p11[KALMAN_LANES];
+    // measurement variance of the current frame, 0 for the channels that are not measured
+    alignas(16) float noise[KALMAN_LANES];
+    alignas(16) float measured[KALMAN_LANES];
+    double lastTime;
+    bool initialized;
+
+public:
+
+    explicit KalmanFilterBank(const KalmanSettings& settings = DEFAULT_KALMAN);
+
+    const KalmanSettings& getSettings() const;
+    void setSettings(const KalmanSettings& settings);
+
+    void reset();
+
+    // Predicts the filters to time (in seconds) and corrects them with the 75 measured positions
+    void update(const float* measurements, const unsigned char* trackingStates, double time);
+
+    // Filtered positions and velocities (in clip units per second) of the last update, 75 channels each
+    const float* getPositions() const;
+    const float* getVelocities() const;
+
+    // Updates the bank with a frame and replaces its positions with the filtered ones
+    void process(BodyFrame& frame);
+
+};
+
+
+#endif //INC_3D_AVATAR_KALMANFILTERBANK_H
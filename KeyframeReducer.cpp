@@ -0,0 +1,118 @@
+#include "KeyframeReducer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Largest distance between a joint of the keys [from, to] of clip and the same joint sampled at their times from
+// the keys listed in keys, with the sampler of the given mode
+static float getDeviation(const Clip& clip, const std::vector<int>& keys, int from, int to, SampleMode mode) {
+
+    Clip reduced;
+    for(int key : keys) {
+        reduced.addFrame(clip.getFrame(key), clip.getTime(key));
+    }
+    ClipSampler sampler(&reduced, mode);
+    float pose[NUM_CHANNELS];
+    float worst = 0.0f;
+
+    for(int i = from; i <= to; i++) {
+        sampler.sample(clip.getTime(i), pose);
+        const float* key = clip.getFrame(i);
+        for(int j = 0; j < NUM_JOINTS; j++) {
+            float distance2 = 0.0f;
+            for(int c = 3 * j; c < 3 * j + 3; c++) {
+                distance2 += (pose[c] - key[c]) * (pose[c] - key[c]);
+            }
+            worst = std::max(worst, std::sqrt(distance2));
+        }
+    }
+    return worst;
+
+}
+
+Clip reduceKeyframes(const Clip& clip, float tolerance, SampleMode mode) {
+
+    int numFrames = clip.getNumFrames();
+    if(numFrames < 3) {
+        return clip;
+    }
+
+    // the kept keys as a doubly linked list over the key indices
+    std::vector<int> previous(numFrames);
+    std::vector<int> next(numFrames);
+    for(int i = 0; i < numFrames; i++) {
+        previous[i] = i - 1;
+        next[i] = i + 1;
+    }
+
+    // Removing a key only changes the segments of the two kept keys on either side of it (a Catmull-Rom tangent
+    // depends on the neighbouring keys), and those only depend on one more key on either side. So removing it is
+    // checked by sampling the three kept keys on either side at the times of all the original keys in between.
+    std::vector<int> keys;
+    bool removed = true;
+    while(removed) {
+
+        removed = false;
+        for(int k = next[0]; k < numFrames - 1; k = next[k]) {
+
+            keys.clear();
+            int first = k;
+            for(int n = 0; n < 3 && previous[first] >= 0; n++) {
+                first = previous[first];
+            }
+            for(int i = first, after = 0; i < numFrames && after < 3; i = next[i]) {
+                if(i != k) {
+                    keys.push_back(i);
+                }
+                if(i > k) {
+                    after++;
+                }
+            }
+
+            int from = previous[k] >= 0 && previous[previous[k]] >= 0 ? previous[previous[k]] : 0;
+            int to = next[k] < numFrames - 1 ? next[next[k]] : numFrames - 1;
+            if(getDeviation(clip, keys, from, to, mode) <= tolerance) {
+                next[previous[k]] = next[k];
+                previous[next[k]] = previous[k];
+                removed = true;
+            }
+
+        }
+
+    }
+
+    Clip reduced;
+    if(clip.hasFloorPlane()) {
+        reduced.setFloorPlane(clip.getFloorPlane());
+    }
+    for(int i = 0; i < numFrames; i = next[i]) {
+        reduced.addFrame(clip.getFrame(i), clip.getTime(i),
+                         clip.hasOrientations() ? clip.getOrientations(i) : nullptr, clip.getTrackingStates(i));
+    }
+
+    return reduced;
+
+}
+
+float getReconstructionError(const Clip& original, const Clip& reduced, SampleMode mode) {
+
+    ClipSampler sampler(&reduced, mode);
+    float pose[NUM_CHANNELS];
+    float maxError = 0.0f;
+
+    for(int i = 0; i < original.getNumFrames(); i++) {
+        sampler.sample(original.getTime(i), pose);
+        const float* key = original.getFrame(i);
+        for(int j = 0; j < NUM_JOINTS; j++) {
+            float distance2 = 0.0f;
+            for(int c = 3 * j; c < 3 * j + 3; c++) {
+                distance2 += (pose[c] - key[c]) * (pose[c] - key[c]);
+            }
+            maxError = std::max(maxError, std::sqrt(distance2));
+        }
+    }
+
+    return maxError;
+
+}
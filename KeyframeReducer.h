@@ -0,0 +1,18 @@
+#ifndef INC_3D_AVATAR_KEYFRAMEREDUCER_H
+#define INC_3D_AVATAR_KEYFRAMEREDUCER_H
+
+#include "Clip.h"
+#include "ClipSampler.h"
+
+// Drops the redundant keys of a clip: a key is removed when the clip sampled without it, with the interpolation of
+// mode (the one playback uses by default), still passes within tolerance (in clip units, i.e. CLIP_SCALE times
+// metres) of every joint of every original key. Each removal is checked against the keys already removed, so the
+// bound holds for the whole result. All the joints share the keys, so the result is an ordinary clip with uneven key
+// times, which the samplers interpolate directly.
+Clip reduceKeyframes(const Clip& clip, float tolerance, SampleMode mode = SAMPLE_CATMULL_ROM);
+
+// Largest distance between a joint of the original keys and the same joint sampled from the reduced clip
+float getReconstructionError(const Clip& original, const Clip& reduced, SampleMode mode);
+
+
+#endif //INC_3D_AVATAR_KEYFRAMEREDUCER_H
@@ -119,8 +119,10 @@ while true
             % To get the joints on depth image space, you can use:
             %pos2D = k2.mapCameraPoints2Depth(bodies(1).Position');
             buffer(1).Position = bodies(1).Position;
-            buffer(1).Orientation = bodies(1).Position;
+            buffer(1).Orientation = bodies(1).Orientation;
             buffer(1).TrackingState = bodies(1).TrackingState;
+            buffer(1).TimeStamp = timeStamp;
+            buffer(1).FloorClipPlane = fcp;
             
             cellBuffer = struct2cell(buffer);
             tableBuffer = cell2table(cellBuffer(1:end,:));
@@ -160,8 +162,10 @@ k2.delete;
 
 % Storing the joints in a .csv file
 % format: Pos: var1_x | var1_y | var1_z | var2_x | var2_y | var2_z | ...
-% format: Or: var1_x | var1_y | var1_z | var2_x | var2_y | var2_z | ...
+% format: Or: var1_x | var1_y | var1_z | var1_w | var2_x | var2_y | var2_z | var2_w | ...
 % format: State: var1 | var2 | ...
+% format: TimeStamp: var1 (Kinect relative time, in 100 ns ticks)
+% format: FloorClipPlane: var1_x | var1_y | var1_z | var1_w (floor: x X + y Y + z Z + w = 0, in meters)
 cellBuffer = struct2cell(buffer);
 tableBuffer = cell2table(cellBuffer(1:end,:));
 %writetable(tableBuffer, 'testfile2.csv')
@@ -0,0 +1,122 @@
+#include "OneEuroFilter.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Skeleton.h"
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define ONE_EURO_SSE
+#endif
+
+const float TWO_PI = 6.28318530718f;
+
+OneEuroFilter::OneEuroFilter(const OneEuroSettings& torso, const OneEuroSettings& hands) {
+
+    setSettings(torso, hands);
+    reset();
+
+}
+
+void OneEuroFilter::setSettings(const OneEuroSettings& torso, const OneEuroSettings& hands) {
+
+    for(int j = 0; j < NUM_JOINTS; j++) {
+        setJointSettings(j, isHand(j) ? hands : torso);
+    }
+
+    // the padding lanes filter a constant zero
+    for(int c = NUM_CHANNELS; c < ONE_EURO_LANES; c++) {
+        minCutoff[c] = torso.minCutoff;
+        beta[c] = torso.beta;
+        derivativeCutoff[c] = torso.derivativeCutoff;
+    }
+
+}
+
+void OneEuroFilter::setJointSettings(int joint, const OneEuroSettings& settings) {
+
+    for(int c = 3 * joint; c < 3 * joint + 3; c++) {
+        minCutoff[c] = settings.minCutoff;
+        beta[c] = settings.beta;
+        derivativeCutoff[c] = settings.derivativeCutoff;
+    }
+
+}
+
+void OneEuroFilter::reset() {
+
+    std::fill(previous, previous + ONE_EURO_LANES, 0.0f);
+    std::fill(derivative, derivative + ONE_EURO_LANES, 0.0f);
+    lastTime = 0.0;
+    initialized = false;
+
+}
+
+void OneEuroFilter::filter(float* positions, double time) {
+
+    if(!initialized || time <= lastTime) {
+        // nothing to filter against yet (or the clock went back): start from this frame
+        std::copy(positions, positions + NUM_CHANNELS, previous);
+        std::fill(derivative, derivative + ONE_EURO_LANES, 0.0f);
+        lastTime = time;
+        initialized = true;
+        return;
+    }
+
+    float dt = (float)(time - lastTime);
+    lastTime = time;
+
+    alignas(16) float x[ONE_EURO_LANES] = {};
+    std::copy(positions, positions + NUM_CHANNELS, x);
+
+    // smoothing factor of a first-order low-pass at cutoff fc: 1 / (1 + 1 / (2 pi fc dt))
+#ifdef ONE_EURO_SSE
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 rate = _mm_set1_ps(1.0f / dt);
+    __m128 twoPiDt = _mm_set1_ps(TWO_PI * dt);
+
+    for(int c = 0; c < ONE_EURO_LANES; c += 4) {
+
+        __m128 value = _mm_load_ps(x + c);
+        __m128 last = _mm_load_ps(previous + c);
+
+        __m128 alphaD = _mm_mul_ps(twoPiDt, _mm_load_ps(derivativeCutoff + c));
+        alphaD = _mm_div_ps(alphaD, _mm_add_ps(alphaD, one));
+        __m128 speed = _mm_mul_ps(_mm_sub_ps(value, last), rate);
+        __m128 d = _mm_load_ps(derivative + c);
+        d = _mm_add_ps(d, _mm_mul_ps(alphaD, _mm_sub_ps(speed, d)));
+
+        __m128 absD = _mm_max_ps(d, _mm_sub_ps(_mm_setzero_ps(), d));
+        __m128 cutoff = _mm_add_ps(_mm_load_ps(minCutoff + c), _mm_mul_ps(_mm_load_ps(beta + c), absD));
+        __m128 alpha = _mm_mul_ps(twoPiDt, cutoff);
+        alpha = _mm_div_ps(alpha, _mm_add_ps(alpha, one));
+        last = _mm_add_ps(last, _mm_mul_ps(alpha, _mm_sub_ps(value, last)));
+
+        _mm_store_ps(derivative + c, d);
+        _mm_store_ps(previous + c, last);
+
+    }
+#else
+    for(int c = 0; c < ONE_EURO_LANES; c++) {
+
+        float alphaD = TWO_PI * dt * derivativeCutoff[c];
+        alphaD /= alphaD + 1;
+        derivative[c] += alphaD * ((x[c] - previous[c]) / dt - derivative[c]);
+
+        float alpha = TWO_PI * dt * (minCutoff[c] + beta[c] * std::fabs(derivative[c]));
+        alpha /= alpha + 1;
+        previous[c] += alpha * (x[c] - previous[c]);
+
+    }
+#endif
+
+    std::copy(previous, previous + NUM_CHANNELS, positions);
+
+}
+
+void OneEuroFilter::process(BodyFrame& frame) {
+
+    filter(frame.positions, frame.time);
+
+}
@@ -0,0 +1,56 @@
+#ifndef INC_3D_AVATAR_ONEEUROFILTER_H
+#define INC_3D_AVATAR_ONEEUROFILTER_H
+
+#include "Clip.h"
+
+// 75 channels padded to a whole number of 4-float SIMD lanes
+const int ONE_EURO_LANES = (NUM_CHANNELS + 3) / 4 * 4;
+
+struct OneEuroSettings {
+    float minCutoff;            // cutoff frequency at rest, in Hz: lower removes more jitter
+    float beta;                 // cutoff increase per unit of speed (clip units per second): higher lags less
+    float derivativeCutoff;     // cutoff frequency of the speed estimate, in Hz
+};
+
+// Hands move fast and are noisy, the torso is slow and steady (speeds are in clip units, CLIP_SCALE times metres)
+const OneEuroSettings DEFAULT_TORSO_ONE_EURO = {1.0f, 0.3f, 1.0f};
+const OneEuroSettings DEFAULT_HAND_ONE_EURO = {1.5f, 1.0f, 1.0f};
+
+// The One Euro filter (Casiez et al., 2012): a low-pass filter whose cutoff rises with the speed of the signal,
+// so it smooths the jitter of a joint at rest and keeps up with it when it moves. All the channels of a body are
+// filtered together, four at a time.
+class OneEuroFilter {
+
+private:
+
+    alignas(16) float minCutoff[ONE_EURO_LANES];
+    alignas(16) float beta[ONE_EURO_LANES];
+    alignas(16) float derivativeCutoff[ONE_EURO_LANES];
+
+    // filter state: the last output and the filtered speed of every channel
+    alignas(16) float previous[ONE_EURO_LANES];
+    alignas(16) float derivative[ONE_EURO_LANES];
+    double lastTime;
+    bool initialized;
+
+public:
+
+    explicit OneEuroFilter(const OneEuroSettings& torso = DEFAULT_TORSO_ONE_EURO,
+                           const OneEuroSettings& hands = DEFAULT_HAND_ONE_EURO);
+
+    void setSettings(const OneEuroSettings& torso, const OneEuroSettings& hands);
+
+    // Settings of a single joint, e.g. to tune the head apart from the rest of the torso
+    void setJointSettings(int joint, const OneEuroSettings& settings);
+
+    void reset();
+
+    // Filters the 75 positions of a frame taken at time (in seconds) in place
+    void filter(float* positions, double time);
+
+    void process(BodyFrame& frame);
+
+};
+
+
+#endif //INC_3D_AVATAR_ONEEUROFILTER_H
@@ -0,0 +1,133 @@
+#include "Orientation.h"
+
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define ORIENTATION_SSE
+#endif
+
+void slerpOrientation(const float* from, const float* to, float u, float* out) {
+
+    float dot = from[0] * to[0] + from[1] * to[1] + from[2] * to[2] + from[3] * to[3];
+    // q and -q are the same rotation: flipping the target keeps the interpolation on the shortest arc
+    float sign = dot < 0 ? -1.0f : 1.0f;
+    dot = std::fabs(dot);
+
+    float w0 = 1 - u;
+    float w1 = u;
+    if(dot < 0.9999f) {
+        float angle = std::acos(dot);
+        float sinAngle = std::sin(angle);
+        w0 = std::sin((1 - u) * angle) / sinAngle;
+        w1 = std::sin(u * angle) / sinAngle;
+    }
+
+    float length = 0.0f;
+    for(int i = 0; i < 4; i++) {
+        out[i] = w0 * from[i] + w1 * sign * to[i];
+        length += out[i] * out[i];
+    }
+    length = std::sqrt(length);
+    for(int i = 0; i < 4; i++) {
+        out[i] /= length;
+    }
+
+}
+
+// Scalar version of the batched nlerp, used for the joints left over by the SIMD loop
+static void interpolateOrientation(const float* from, const float* to, float u, float* out) {
+
+    float dot = from[0] * to[0] + from[1] * to[1] + from[2] * to[2] + from[3] * to[3];
+    if(std::fabs(dot) < NLERP_MIN_DOT) {
+        slerpOrientation(from, to, u, out);
+        return;
+    }
+
+    float sign = dot < 0 ? -1.0f : 1.0f;
+    float length = 0.0f;
+    for(int i = 0; i < 4; i++) {
+        out[i] = from[i] + (sign * to[i] - from[i]) * u;
+        length += out[i] * out[i];
+    }
+    length = std::sqrt(length);
+    for(int i = 0; i < 4; i++) {
+        out[i] /= length;
+    }
+
+}
+
+void interpolateOrientations(const float* from, const float* to, float u, float* out) {
+
+    int joint = 0;
+
+#ifdef ORIENTATION_SSE
+    const __m128 weight = _mm_set1_ps(u);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 minDot = _mm_set1_ps(NLERP_MIN_DOT);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 threeHalves = _mm_set1_ps(1.5f);
+
+    for(; joint + 4 <= NUM_JOINTS; joint += 4) {
+
+        // four quaternions per register, transposed so that each register holds one component of four joints
+        __m128 ax = _mm_loadu_ps(from + 4 * joint);
+        __m128 ay = _mm_loadu_ps(from + 4 * joint + 4);
+        __m128 az = _mm_loadu_ps(from + 4 * joint + 8);
+        __m128 aw = _mm_loadu_ps(from + 4 * joint + 12);
+        _MM_TRANSPOSE4_PS(ax, ay, az, aw);
+        __m128 bx = _mm_loadu_ps(to + 4 * joint);
+        __m128 by = _mm_loadu_ps(to + 4 * joint + 4);
+        __m128 bz = _mm_loadu_ps(to + 4 * joint + 8);
+        __m128 bw = _mm_loadu_ps(to + 4 * joint + 12);
+        _MM_TRANSPOSE4_PS(bx, by, bz, bw);
+
+        __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+                                _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+
+        // hemisphere correction: the sign bit of the dot product flips the target quaternion
+        __m128 sign = _mm_and_ps(dot, signMask);
+        bx = _mm_xor_ps(bx, sign);
+        by = _mm_xor_ps(by, sign);
+        bz = _mm_xor_ps(bz, sign);
+        bw = _mm_xor_ps(bw, sign);
+        dot = _mm_xor_ps(dot, sign);
+
+        __m128 rx = _mm_add_ps(ax, _mm_mul_ps(_mm_sub_ps(bx, ax), weight));
+        __m128 ry = _mm_add_ps(ay, _mm_mul_ps(_mm_sub_ps(by, ay), weight));
+        __m128 rz = _mm_add_ps(az, _mm_mul_ps(_mm_sub_ps(bz, az), weight));
+        __m128 rw = _mm_add_ps(aw, _mm_mul_ps(_mm_sub_ps(bw, aw), weight));
+
+        // approximate reciprocal square root, refined with one Newton-Raphson step
+        __m128 length2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)),
+                                    _mm_add_ps(_mm_mul_ps(rz, rz), _mm_mul_ps(rw, rw)));
+        __m128 inverse = _mm_rsqrt_ps(length2);
+        inverse = _mm_mul_ps(inverse, _mm_sub_ps(threeHalves,
+                _mm_mul_ps(_mm_mul_ps(half, length2), _mm_mul_ps(inverse, inverse))));
+        rx = _mm_mul_ps(rx, inverse);
+        ry = _mm_mul_ps(ry, inverse);
+        rz = _mm_mul_ps(rz, inverse);
+        rw = _mm_mul_ps(rw, inverse);
+
+        _MM_TRANSPOSE4_PS(rx, ry, rz, rw);
+        _mm_storeu_ps(out + 4 * joint, rx);
+        _mm_storeu_ps(out + 4 * joint + 4, ry);
+        _mm_storeu_ps(out + 4 * joint + 8, rz);
+        _mm_storeu_ps(out + 4 * joint + 12, rw);
+
+        // joints rotating too much for nlerp are redone exactly
+        int needsSlerp = _mm_movemask_ps(_mm_cmplt_ps(dot, minDot));
+        for(int lane = 0; needsSlerp != 0; lane++, needsSlerp >>= 1) {
+            if(needsSlerp & 1) {
+                slerpOrientation(from + 4 * (joint + lane), to + 4 * (joint + lane), u, out + 4 * (joint + lane));
+            }
+        }
+
+    }
+#endif
+
+    for(; joint < NUM_JOINTS; joint++) {
+        interpolateOrientation(from + 4 * joint, to + 4 * joint, u, out + 4 * joint);
+    }
+
+}
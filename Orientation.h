@@ -0,0 +1,18 @@
+#ifndef INC_3D_AVATAR_ORIENTATION_H
+#define INC_3D_AVATAR_ORIENTATION_H
+
+#include "Clip.h"
+
+// Below this cosine between two quaternions (about 36 degrees of rotation) nlerp drifts up to 0.1 degrees from
+// the exact slerp, so the slower slerp is used instead
+const float NLERP_MIN_DOT = 0.95f;
+
+// Exact spherical interpolation of a single quaternion (x, y, z, w), taking the shortest path
+void slerpOrientation(const float* from, const float* to, float u, float* out);
+
+// Interpolates the NUM_JOINTS quaternions of two frames at once: nlerp on four joints per SIMD register, with the
+// shortest-path (hemisphere) correction, falling back to slerpOrientation() for the joints that rotate too much
+void interpolateOrientations(const float* from, const float* to, float u, float* out);
+
+
+#endif //INC_3D_AVATAR_ORIENTATION_H
@@ -0,0 +1,217 @@
+#include "OutlierRejector.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Skeleton.h"
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define OUTLIER_SSE
+#endif
+
+OutlierRejector::OutlierRejector(const OutlierSettings& settings) {
+
+    setSettings(settings);
+    reset();
+    resetMetrics();
+
+}
+
+const OutlierSettings& OutlierRejector::getSettings() const {
+    return settings;
+}
+
+void OutlierRejector::setSettings(const OutlierSettings& settings) {
+
+    OutlierRejector::settings = settings;
+    for(int j = 0; j < OUTLIER_LANES; j++) {
+        float speed = CLIP_SCALE * (j < NUM_JOINTS && isHand(j) ? settings.maxHandSpeed : settings.maxSpeed);
+        maxSpeed2[j] = speed * speed;
+    }
+
+}
+
+void OutlierRejector::reset() {
+
+    for(int c = 0; c < 3; c++) {
+        std::fill(previous[c], previous[c] + OUTLIER_LANES, 0.0f);
+        std::fill(velocity[c], velocity[c] + OUTLIER_LANES, 0.0f);
+    }
+    std::fill(rejectedRuns, rejectedRuns + OUTLIER_LANES, 0.0f);
+    std::fill(velocityScales, velocityScales + OUTLIER_LANES, 1.0f);
+    lastTime = 0.0;
+    numFrames = 0;
+    rejectedInARow = 0;
+
+}
+
+const RejectionMetrics& OutlierRejector::getMetrics() const {
+    return metrics;
+}
+
+void OutlierRejector::resetMetrics() {
+    metrics = {};
+}
+
+void OutlierRejector::accept(const float* positions, float dt) {
+
+    for(int j = 0; j < NUM_JOINTS; j++) {
+        for(int c = 0; c < 3; c++) {
+            velocity[c][j] = dt > 0 ? (positions[3 * j + c] - previous[c][j]) / dt * velocityScales[j] : 0.0f;
+            previous[c][j] = positions[3 * j + c];
+        }
+    }
+
+}
+
+void OutlierRejector::process(float* positions, double time) {
+
+    metrics.numFrames++;
+    if(numFrames == 0 || time <= lastTime) {
+        reset();
+        accept(positions, 0.0f);
+        lastTime = time;
+        numFrames = 1;
+        return;
+    }
+
+    float dt = (float)(time - lastTime);
+    lastTime = time;
+
+    // measured and predicted joints, one array per axis
+    alignas(16) float measured[3][OUTLIER_LANES] = {};
+    alignas(16) float predicted[3][OUTLIER_LANES];
+    for(int j = 0; j < NUM_JOINTS; j++) {
+        for(int c = 0; c < 3; c++) {
+            measured[c][j] = positions[3 * j + c];
+        }
+    }
+    for(int c = 0; c < 3; c++) {
+        for(int j = 0; j < OUTLIER_LANES; j++) {
+            predicted[c][j] = previous[c][j] + velocity[c][j] * dt;
+        }
+    }
+
+    // the whole body: how far its centroid moved since the last frame
+    float jump[3] = {};
+    for(int c = 0; c < 3; c++) {
+        for(int j = 0; j < NUM_JOINTS; j++) {
+            jump[c] += measured[c][j] - previous[c][j];
+        }
+    }
+    float maxJump = CLIP_SCALE * settings.maxBodyJump * NUM_JOINTS;
+    if(jump[0] * jump[0] + jump[1] * jump[1] + jump[2] * jump[2] > maxJump * maxJump) {
+        if(++rejectedInARow <= settings.maxRejectedFrames) {
+            metrics.rejectedFrames++;
+            for(int j = 0; j < NUM_JOINTS; j++) {
+                for(int c = 0; c < 3; c++) {
+                    positions[3 * j + c] = predicted[c][j];
+                }
+            }
+            std::fill(velocityScales, velocityScales + OUTLIER_LANES, 0.5f);
+            accept(positions, dt);
+            return;
+        }
+        // the jump lasted: it is a different body, start over from it
+        metrics.resets++;
+        reset();
+        accept(positions, 0.0f);
+        lastTime = time;
+        numFrames = 1;
+        return;
+    }
+    rejectedInARow = 0;
+
+    // a joint is rejected when its speed or its acceleration (its miss from the constant velocity prediction) is
+    // past the limits, unless it has been for maxRejectedFrames already; the acceleration is only known from the
+    // third frame on. A rejected joint keeps half its velocity, so the prediction doesn't run away, and a joint
+    // accepted after a rejected run starts again at rest.
+    float rate2 = 1 / (dt * dt);
+    float maxMiss = CLIP_SCALE * settings.maxAcceleration * dt * dt;
+    float maxMiss2 = numFrames >= 2 ? maxMiss * maxMiss : INFINITY;
+    int rejected = 0;
+
+#ifdef OUTLIER_SSE
+    static const int bitCounts[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+    __m128 rate2s = _mm_set1_ps(rate2);
+    __m128 maxMiss2s = _mm_set1_ps(maxMiss2);
+    __m128 maxRuns = _mm_set1_ps((float)settings.maxRejectedFrames);
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 half = _mm_set1_ps(0.5f);
+
+    for(int j = 0; j < OUTLIER_LANES; j += 4) {
+
+        __m128 x = _mm_load_ps(measured[0] + j);
+        __m128 y = _mm_load_ps(measured[1] + j);
+        __m128 z = _mm_load_ps(measured[2] + j);
+        __m128 px = _mm_load_ps(predicted[0] + j);
+        __m128 py = _mm_load_ps(predicted[1] + j);
+        __m128 pz = _mm_load_ps(predicted[2] + j);
+
+        __m128 dx = _mm_sub_ps(x, _mm_load_ps(previous[0] + j));
+        __m128 dy = _mm_sub_ps(y, _mm_load_ps(previous[1] + j));
+        __m128 dz = _mm_sub_ps(z, _mm_load_ps(previous[2] + j));
+        __m128 speed2 = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)),
+                                   rate2s);
+
+        __m128 mx = _mm_sub_ps(x, px);
+        __m128 my = _mm_sub_ps(y, py);
+        __m128 mz = _mm_sub_ps(z, pz);
+        __m128 miss2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(mx, mx), _mm_mul_ps(my, my)), _mm_mul_ps(mz, mz));
+
+        __m128 outside = _mm_or_ps(_mm_cmpgt_ps(speed2, _mm_load_ps(maxSpeed2 + j)), _mm_cmpgt_ps(miss2, maxMiss2s));
+        __m128 runs = _mm_load_ps(rejectedRuns + j);
+        __m128 allowed = _mm_cmplt_ps(runs, maxRuns);
+        __m128 reject = _mm_and_ps(outside, allowed);
+        __m128 forced = _mm_andnot_ps(allowed, outside);
+        _mm_store_ps(rejectedRuns + j, _mm_and_ps(reject, _mm_add_ps(runs, one)));
+        _mm_store_ps(velocityScales + j, _mm_sub_ps(one, _mm_or_ps(_mm_and_ps(reject, half), _mm_and_ps(forced, one))));
+        rejected += bitCounts[_mm_movemask_ps(reject)];
+
+        _mm_store_ps(measured[0] + j, _mm_or_ps(_mm_and_ps(reject, px), _mm_andnot_ps(reject, x)));
+        _mm_store_ps(measured[1] + j, _mm_or_ps(_mm_and_ps(reject, py), _mm_andnot_ps(reject, y)));
+        _mm_store_ps(measured[2] + j, _mm_or_ps(_mm_and_ps(reject, pz), _mm_andnot_ps(reject, z)));
+
+    }
+#else
+    for(int j = 0; j < OUTLIER_LANES; j++) {
+
+        float speed2 = 0.0f;
+        float miss2 = 0.0f;
+        for(int c = 0; c < 3; c++) {
+            float d = measured[c][j] - previous[c][j];
+            float m = measured[c][j] - predicted[c][j];
+            speed2 += d * d;
+            miss2 += m * m;
+        }
+
+        bool outside = speed2 * rate2 > maxSpeed2[j] || miss2 > maxMiss2;
+        bool allowed = rejectedRuns[j] < settings.maxRejectedFrames;
+        bool reject = outside && allowed;
+        rejectedRuns[j] = reject ? rejectedRuns[j] + 1 : 0.0f;
+        velocityScales[j] = reject ? 0.5f : (outside ? 0.0f : 1.0f);
+        rejected += reject;
+        for(int c = 0; c < 3; c++) {
+            measured[c][j] = reject ? predicted[c][j] : measured[c][j];
+        }
+
+    }
+#endif
+
+    metrics.rejectedJoints += rejected;
+    for(int j = 0; j < NUM_JOINTS; j++) {
+        for(int c = 0; c < 3; c++) {
+            positions[3 * j + c] = measured[c][j];
+        }
+    }
+    accept(positions, dt);
+    numFrames = std::min(numFrames + 1, 2);
+
+}
+
+void OutlierRejector::process(BodyFrame& frame) {
+
+    process(frame.positions, frame.time);
+
+}
@@ -0,0 +1,71 @@
+#ifndef INC_3D_AVATAR_OUTLIERREJECTOR_H
+#define INC_3D_AVATAR_OUTLIERREJECTOR_H
+
+#include "Clip.h"
+
+// 25 joints padded to a whole number of 4-float SIMD lanes
+const int OUTLIER_LANES = (NUM_JOINTS + 3) / 4 * 4;
+
+struct OutlierSettings {
+    float maxSpeed;             // fastest a torso or leg joint moves, in metres per second
+    float maxHandSpeed;         // the same for the wrists and hands
+    float maxAcceleration;      // largest acceleration of any joint, in metres per second squared
+    float maxBodyJump;          // largest move of the whole body between two frames, in metres
+    int maxRejectedFrames;      // after this many rejected frames in a row a joint, or the body, is accepted as it is
+};
+
+// Well beyond what a person does, well below what an identity swap or a teleporting joint does
+const OutlierSettings DEFAULT_OUTLIER = {5.0f, 12.0f, 250.0f, 0.5f, 5};
+
+struct RejectionMetrics {
+    long numFrames;             // frames processed
+    long rejectedJoints;        // joint samples replaced by their prediction
+    long rejectedFrames;        // whole frames replaced, because the body jumped
+    long resets;                // jumps accepted after maxRejectedFrames, e.g. when a new person is tracked
+};
+
+// Rejects the samples of live frames that no body could produce: a joint moving or accelerating past the limits
+// is replaced by its constant velocity prediction, and so is the whole frame when the body's centroid jumps. The
+// joints are checked four at a time, without branches.
+class OutlierRejector {
+
+private:
+
+    OutlierSettings settings;
+    RejectionMetrics metrics;
+
+    // last accepted position and velocity of every joint, one array per axis
+    alignas(16) float previous[3][OUTLIER_LANES];
+    alignas(16) float velocity[3][OUTLIER_LANES];
+    alignas(16) float maxSpeed2[OUTLIER_LANES];
+    // frames in a row each joint was rejected, as floats to stay in the SIMD lanes
+    alignas(16) float rejectedRuns[OUTLIER_LANES];
+    // how much of its velocity each joint keeps for the next prediction
+    alignas(16) float velocityScales[OUTLIER_LANES];
+    double lastTime;
+    int numFrames;
+    int rejectedInARow;
+
+    void accept(const float* positions, float dt);
+
+public:
+
+    explicit OutlierRejector(const OutlierSettings& settings = DEFAULT_OUTLIER);
+
+    const OutlierSettings& getSettings() const;
+    void setSettings(const OutlierSettings& settings);
+
+    void reset();
+
+    const RejectionMetrics& getMetrics() const;
+    void resetMetrics();
+
+    // Checks the 75 positions of a frame taken at time (in seconds), replacing the rejected ones in place
+    void process(float* positions, double time);
+
+    void process(BodyFrame& frame);
+
+};
+
+
+#endif //INC_3D_AVATAR_OUTLIERREJECTOR_H
@@ -0,0 +1,93 @@
+#include "PlaybackController.h"
+
+#include <algorithm>
+#include <cmath>
+
+void PlaybackController::wrap() {
+
+    if(duration <= 0) {
+        time = 0.0;
+    }
+    else if(looping) {
+        time = std::fmod(time, duration);
+        if(time < 0) {
+            time += duration;
+        }
+    }
+    else {
+        time = std::max(0.0, std::min(time, duration));
+    }
+
+}
+
+double PlaybackController::getDuration() const {
+    return duration;
+}
+
+void PlaybackController::setDuration(double duration) {
+    PlaybackController::duration = duration;
+    wrap();
+}
+
+void PlaybackController::update(double elapsed) {
+
+    if(!paused) {
+        time += elapsed * speed;
+        wrap();
+    }
+
+}
+
+void PlaybackController::seek(double time) {
+    PlaybackController::time = time;
+    // the end of the clip is a position of its own, not the start of the next loop
+    if(time != duration) {
+        wrap();
+    }
+}
+
+void PlaybackController::scrub(double offset) {
+    seek(time + offset);
+}
+
+double PlaybackController::getTime() const {
+    return time;
+}
+
+float PlaybackController::getSpeed() const {
+    return speed;
+}
+
+void PlaybackController::setSpeed(float speed) {
+    float magnitude = std::max(MIN_PLAYBACK_SPEED, std::min(std::fabs(speed), MAX_PLAYBACK_SPEED));
+    PlaybackController::speed = speed < 0 ? -magnitude : magnitude;
+}
+
+void PlaybackController::faster() {
+    setSpeed(2 * speed);
+}
+
+void PlaybackController::slower() {
+    setSpeed(speed / 2);
+}
+
+void PlaybackController::reverse() {
+    speed = -speed;
+}
+
+bool PlaybackController::isPaused() const {
+    return paused;
+}
+
+void PlaybackController::togglePause() {
+    paused = !paused;
+}
+
+bool PlaybackController::isLooping() const {
+    return looping;
+}
+
+void PlaybackController::setLooping(bool looping) {
+    PlaybackController::looping = looping;
+    wrap();
+}
@@ -0,0 +1,72 @@
+#ifndef INC_3D_AVATAR_PLAYBACKCONTROLLER_H
+#define INC_3D_AVATAR_PLAYBACKCONTROLLER_H
+
+// Speeds the controller steps through when speeding up or slowing down
+const float MIN_PLAYBACK_SPEED = 0.125f;
+const float MAX_PLAYBACK_SPEED = 8.0f;
+
+// Keeps the playback position inside a clip: slow motion, fast-forward, reverse, pause and scrubbing. It only deals
+// with time: the pose at that time is then a constant-time lookup in the clip (see ClipSampler::findKey()).
+class PlaybackController {
+
+private:
+
+    double duration;
+    double time;
+    float speed;
+    bool paused;
+    bool looping;
+
+    void wrap();
+
+public:
+
+    explicit PlaybackController(double duration = 0.0) {
+
+        this->duration = duration;
+        this->time = 0.0;
+        this->speed = 1.0f;
+        this->paused = false;
+        this->looping = true;
+
+    }
+
+    double getDuration() const;
+
+    void setDuration(double duration);
+
+    // Advances the playback by the given wall-clock time, at the current speed and direction
+    void update(double elapsed);
+
+    // Jumps to an absolute time in the clip, in seconds. Seeking to the duration stays on the last key, even when
+    // looping.
+    void seek(double time);
+
+    // Moves the playback position by the given clip time, whatever the speed and even when paused
+    void scrub(double offset);
+
+    double getTime() const;
+
+    float getSpeed() const;
+
+    void setSpeed(float speed);
+
+    // Doubles / halves the speed, keeping the direction
+    void faster();
+
+    void slower();
+
+    void reverse();
+
+    bool isPaused() const;
+
+    void togglePause();
+
+    bool isLooping() const;
+
+    void setLooping(bool looping);
+
+};
+
+
+#endif //INC_3D_AVATAR_PLAYBACKCONTROLLER_H
@@ -0,0 +1,145 @@
+#include "PosePredictor.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Skeleton.h"
+
+PosePredictor::PosePredictor(const PredictionSettings& settings) {
+
+    this->settings = settings;
+    reset();
+
+}
+
+const PredictionSettings& PosePredictor::getSettings() const {
+    return settings;
+}
+
+void PosePredictor::setSettings(const PredictionSettings& settings) {
+    PosePredictor::settings = settings;
+}
+
+void PosePredictor::reset() {
+
+    numFrames = 0;
+
+}
+
+void PosePredictor::observe(const float* positions, double time) {
+
+    if(numFrames > 0 && time <= times[0]) {
+        numFrames = 0;
+    }
+
+    std::copy(history[1], history[1] + NUM_CHANNELS, history[2]);
+    std::copy(history[0], history[0] + NUM_CHANNELS, history[1]);
+    std::copy(positions, positions + NUM_CHANNELS, history[0]);
+    times[2] = times[1];
+    times[1] = times[0];
+    times[0] = time;
+    numFrames = std::min(numFrames + 1, 3);
+
+}
+
+void PosePredictor::predict(float horizon, float* out) const {
+
+    if(numFrames < 2) {
+        std::copy(history[0], history[0] + NUM_CHANNELS, out);
+        return;
+    }
+
+    // backward differences over the (possibly uneven) frame times
+    float dt0 = (float)(times[0] - times[1]);
+    float dt1 = (float)(times[1] - times[2]);
+    float maxAcceleration = CLIP_SCALE * settings.maxAcceleration;
+
+    for(int j = 0; j < NUM_JOINTS; j++) {
+
+        float maxDistance = CLIP_SCALE * (isHand(j) ? settings.maxHandSpeed : settings.maxSpeed) * horizon;
+        float displacement[3];
+        float distance2 = 0.0f;
+
+        for(int c = 3 * j; c < 3 * j + 3; c++) {
+            // the differences give the velocity at the middle of the last interval
+            float velocity = (history[0][c] - history[1][c]) / dt0;
+            float acceleration = 0.0f;
+            if(numFrames == 3) {
+                acceleration = (velocity - (history[1][c] - history[2][c]) / dt1) * 2 / (dt0 + dt1);
+                acceleration *= settings.accelerationWeight;
+                acceleration = std::max(-maxAcceleration, std::min(acceleration, maxAcceleration));
+            }
+            velocity += acceleration * dt0 / 2;
+            float d = velocity * horizon + acceleration * horizon * horizon / 2;
+            displacement[c - 3 * j] = d;
+            distance2 += d * d;
+        }
+
+        float distance = std::sqrt(distance2);
+        float scale = distance > maxDistance ? maxDistance / distance : 1.0f;
+        for(int c = 0; c < 3; c++) {
+            out[3 * j + c] = history[0][3 * j + c] + displacement[c] * scale;
+        }
+
+    }
+
+}
+
+void PosePredictor::process(BodyFrame& frame) {
+
+    observe(frame.positions, frame.time);
+    predict(settings.horizon, frame.positions);
+
+}
+
+PredictionError evaluatePrediction(const Clip& clip, const PredictionSettings& settings) {
+
+    PredictionError error = {};
+    PosePredictor predictor(settings);
+    float predicted[NUM_CHANNELS];
+    int numSamples = 0;
+    // the first recorded frame at least horizon seconds after the current one
+    int target = 0;
+
+    for(int i = 0; i < clip.getNumFrames(); i++) {
+
+        predictor.observe(clip.getFrame(i), clip.getTime(i));
+        while(target < clip.getNumFrames() && clip.getTime(target) < clip.getTime(i) + settings.horizon) {
+            target++;
+        }
+        if(target == clip.getNumFrames()) {
+            break;
+        }
+
+        // predicted to the time the frame was actually recorded, so it is compared with real data, not interpolated
+        predictor.predict(clip.getTime(target) - clip.getTime(i), predicted);
+        error.meanOffset += clip.getTime(target) - clip.getTime(i);
+        const float* actual = clip.getFrame(target);
+        const float* held = clip.getFrame(i);
+
+        for(int j = 0; j < NUM_JOINTS; j++) {
+            float distance2 = 0.0f;
+            float holdDistance2 = 0.0f;
+            for(int c = 3 * j; c < 3 * j + 3; c++) {
+                distance2 += (predicted[c] - actual[c]) * (predicted[c] - actual[c]);
+                holdDistance2 += (held[c] - actual[c]) * (held[c] - actual[c]);
+            }
+            float distance = std::sqrt(distance2) / CLIP_SCALE;
+            float holdDistance = std::sqrt(holdDistance2) / CLIP_SCALE;
+            error.meanError += distance;
+            error.maxError = std::max(error.maxError, distance);
+            error.meanHoldError += holdDistance;
+            error.maxHoldError = std::max(error.maxHoldError, holdDistance);
+            numSamples++;
+        }
+
+    }
+
+    if(numSamples > 0) {
+        error.meanError /= numSamples;
+        error.meanHoldError /= numSamples;
+        error.meanOffset /= numSamples / NUM_JOINTS;
+    }
+    return error;
+
+}
@@ -0,0 +1,64 @@
+#ifndef INC_3D_AVATAR_POSEPREDICTOR_H
+#define INC_3D_AVATAR_POSEPREDICTOR_H
+
+#include "Clip.h"
+
+struct PredictionSettings {
+    float horizon;              // how far ahead the pose is predicted, in seconds
+    float maxSpeed;             // fastest a torso or leg joint plausibly moves, in metres per second
+    float maxHandSpeed;         // the same for the wrists and hands, which are much faster
+    float maxAcceleration;      // largest plausible acceleration, in metres per second squared
+    float accelerationWeight;   // 0 extrapolates the velocity only, 1 the full acceleration, which is noisier
+};
+
+// 40 ms covers the sensor, the CSV round trip and a frame of rendering
+const PredictionSettings DEFAULT_PREDICTION = {0.04f, 3.0f, 8.0f, 40.0f, 0.25f};
+
+// Extrapolates every joint to compensate the latency of the live path: velocity and acceleration come from the last
+// three frames, the acceleration is clamped and so is the distance a joint may be moved, so a noisy or missing frame
+// can't throw a limb out of the body.
+class PosePredictor {
+
+private:
+
+    PredictionSettings settings;
+
+    // the last three frames, newest first
+    float history[3][NUM_CHANNELS];
+    double times[3];
+    int numFrames;
+
+public:
+
+    explicit PosePredictor(const PredictionSettings& settings = DEFAULT_PREDICTION);
+
+    const PredictionSettings& getSettings() const;
+    void setSettings(const PredictionSettings& settings);
+
+    void reset();
+
+    // Adds a frame taken at time (in seconds)
+    void observe(const float* positions, double time);
+
+    // The pose horizon seconds after the last observed frame
+    void predict(float horizon, float* out) const;
+
+    // Observes a frame and replaces its positions with the prediction settings.horizon ahead
+    void process(BodyFrame& frame);
+
+};
+
+// Error of predicting every frame of a recording to the first recorded frame at least horizon seconds later,
+// against that frame
+struct PredictionError {
+    float meanError;            // in metres
+    float maxError;
+    float meanHoldError;        // the same without prediction, i.e. the error of the plain latency
+    float maxHoldError;
+    float meanOffset;           // mean time from a frame to the recorded frame it is scored against, in seconds
+};
+
+PredictionError evaluatePrediction(const Clip& clip, const PredictionSettings& settings);
+
+
+#endif //INC_3D_AVATAR_POSEPREDICTOR_H
@@ -8,6 +8,14 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+// An active uniform of a shader program, found once after linking (slot is -1 for a uniform the program doesn't have)
+struct UniformHandle {
+    int slot;
+};
 
 class Shader {
 public:
@@ -88,6 +96,8 @@ public:
         glDeleteShader(fragment);
         if (geometryPath != nullptr)
             glDeleteShader(geometry);
+        // find the uniforms once, so that the setters never ask the driver for a location
+        reflectUniforms();
 
     }
 
@@ -97,65 +107,172 @@ public:
         glUseProgram(ID);
     }
 
-    // utility uniform functions
+    // the handle of an active uniform, to skip even the name lookup of the setters
+    // ------------------------------------------------------------------------
+    UniformHandle getUniform(const std::string &name) const {
+        auto slot = uniformSlots.find(name);
+        return {slot == uniformSlots.end() ? -1 : slot->second};
+    }
+
+    // utility uniform functions: a value equal to the one the uniform already holds isn't uploaded again
     // ------------------------------------------------------------------------
+    void setBool(UniformHandle uniform, bool value) const {
+        setInt(uniform, (int) value);
+    }
+
     void setBool(const std::string &name, bool value) const {
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), (int) value);
+        setBool(getUniform(name), value);
     }
 
     // ------------------------------------------------------------------------
+    void setInt(UniformHandle uniform, int value) const {
+        if (changed(uniform, &value, sizeof(value)))
+            glUniform1i(uniforms[uniform.slot].location, value);
+    }
+
     void setInt(const std::string &name, int value) const {
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+        setInt(getUniform(name), value);
     }
 
     // ------------------------------------------------------------------------
+    void setFloat(UniformHandle uniform, float value) const {
+        if (changed(uniform, &value, sizeof(value)))
+            glUniform1f(uniforms[uniform.slot].location, value);
+    }
+
     void setFloat(const std::string &name, float value) const {
-        glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+        setFloat(getUniform(name), value);
     }
 
     // ------------------------------------------------------------------------
+    void setVec2(UniformHandle uniform, const glm::vec2 &value) const {
+        if (changed(uniform, &value[0], 2 * sizeof(float)))
+            glUniform2fv(uniforms[uniform.slot].location, 1, &value[0]);
+    }
+
     void setVec2(const std::string &name, const glm::vec2 &value) const {
-        glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+        setVec2(getUniform(name), value);
     }
 
     void setVec2(const std::string &name, float x, float y) const {
-        glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y);
+        setVec2(getUniform(name), glm::vec2(x, y));
     }
 
     // ------------------------------------------------------------------------
+    void setVec3(UniformHandle uniform, const glm::vec3 &value) const {
+        if (changed(uniform, &value[0], 3 * sizeof(float)))
+            glUniform3fv(uniforms[uniform.slot].location, 1, &value[0]);
+    }
+
     void setVec3(const std::string &name, const glm::vec3 &value) const {
-        glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+        setVec3(getUniform(name), value);
     }
 
     void setVec3(const std::string &name, float x, float y, float z) const {
-        glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z);
+        setVec3(getUniform(name), glm::vec3(x, y, z));
     }
 
     // ------------------------------------------------------------------------
+    void setVec4(UniformHandle uniform, const glm::vec4 &value) const {
+        if (changed(uniform, &value[0], 4 * sizeof(float)))
+            glUniform4fv(uniforms[uniform.slot].location, 1, &value[0]);
+    }
+
     void setVec4(const std::string &name, const glm::vec4 &value) const {
-        glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+        setVec4(getUniform(name), value);
     }
 
-    void setVec4(const std::string &name, float x, float y, float z, float w) {
-        glUniform4f(glGetUniformLocation(ID, name.c_str()), x, y, z, w);
+    void setVec4(const std::string &name, float x, float y, float z, float w) const {
+        setVec4(getUniform(name), glm::vec4(x, y, z, w));
     }
 
     // ------------------------------------------------------------------------
+    void setMat2(UniformHandle uniform, const glm::mat2 &mat) const {
+        if (changed(uniform, &mat[0][0], 4 * sizeof(float)))
+            glUniformMatrix2fv(uniforms[uniform.slot].location, 1, GL_FALSE, &mat[0][0]);
+    }
+
     void setMat2(const std::string &name, const glm::mat2 &mat) const {
-        glUniformMatrix2fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        setMat2(getUniform(name), mat);
     }
 
     // ------------------------------------------------------------------------
+    void setMat3(UniformHandle uniform, const glm::mat3 &mat) const {
+        if (changed(uniform, &mat[0][0], 9 * sizeof(float)))
+            glUniformMatrix3fv(uniforms[uniform.slot].location, 1, GL_FALSE, &mat[0][0]);
+    }
+
     void setMat3(const std::string &name, const glm::mat3 &mat) const {
-        glUniformMatrix3fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        setMat3(getUniform(name), mat);
     }
 
     // ------------------------------------------------------------------------
+    void setMat4(UniformHandle uniform, const glm::mat4 &mat) const {
+        if (changed(uniform, &mat[0][0], 16 * sizeof(float)))
+            glUniformMatrix4fv(uniforms[uniform.slot].location, 1, GL_FALSE, &mat[0][0]);
+    }
+
     void setMat4(const std::string &name, const glm::mat4 &mat) const {
-        glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        setMat4(getUniform(name), mat);
     }
 
 private:
+    // location and last uploaded value of an active uniform (a mat4 at most)
+    struct UniformSlot {
+        GLint location;
+        bool known;
+        unsigned char value[16 * sizeof(float)];
+    };
+
+    std::unordered_map<std::string, int> uniformSlots;
+    mutable std::vector<UniformSlot> uniforms;
+
+    // utility function for listing the active uniforms of the program, which start with no known value
+    // ------------------------------------------------------------------------
+    void reflectUniforms() {
+        GLint count = 0;
+        glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+        for (GLint i = 0; i < count; i++) {
+            GLchar name[256];
+            GLsizei length;
+            GLint size;
+            GLenum type;
+            glGetActiveUniform(ID, i, sizeof(name), &length, &size, &type, name);
+            GLint location = glGetUniformLocation(ID, name);
+            // uniforms in blocks have no location, they are set through their buffer
+            if (location < 0)
+                continue;
+            std::string uniformName(name, length);
+            if (uniformName.size() <= 3 || uniformName.compare(uniformName.size() - 3, 3, "[0]") != 0) {
+                uniformSlots[uniformName] = (int) uniforms.size();
+                uniforms.push_back({location, false, {}});
+                continue;
+            }
+            // an array gets a slot per element, its first one also answering to the name without [0]
+            std::string arrayName = uniformName.substr(0, uniformName.size() - 3);
+            uniformSlots[arrayName] = (int) uniforms.size();
+            for (GLint element = 0; element < size; element++) {
+                std::string elementName = arrayName + "[" + std::to_string(element) + "]";
+                uniformSlots[elementName] = (int) uniforms.size();
+                uniforms.push_back({glGetUniformLocation(ID, elementName.c_str()), false, {}});
+            }
+        }
+    }
+
+    // utility function telling whether a value has to be uploaded: the uniform exists and holds something else. The
+    // value is then remembered as the one it holds.
+    // ------------------------------------------------------------------------
+    bool changed(UniformHandle uniform, const void *value, size_t size) const {
+        if (uniform.slot < 0)
+            return false;
+        UniformSlot &slot = uniforms[uniform.slot];
+        if (slot.known && std::memcmp(slot.value, value, size) == 0)
+            return false;
+        std::memcpy(slot.value, value, size);
+        slot.known = true;
+        return true;
+    }
+
     // utility function for checking shader compilation/linking errors.
     // ------------------------------------------------------------------------
     void checkCompileErrors(GLuint shader, std::string type) {
@@ -0,0 +1,28 @@
+#version 460 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec4 aStartRadius;
+layout (location = 2) in vec4 aEndRadius;
+layout (location = 3) in vec3 aColor;
+
+out vec3 actualColor;
+
+uniform mat4 model;
+layout (std140, binding = 0) uniform Camera {
+    mat4 projection;
+    mat4 view;
+};
+
+void main() {
+    // two directions across the bone, from any vector that is not along it
+    vec3 axis = aEndRadius.xyz - aStartRadius.xyz;
+    vec3 direction = length(axis) > 0.0 ? normalize(axis) : vec3(0.0, 0.0, 1.0);
+    vec3 helper = abs(direction.y) < 0.99 ? vec3(0.0, 1.0, 0.0) : vec3(1.0, 0.0, 0.0);
+    vec3 u = normalize(cross(direction, helper));
+    vec3 v = cross(direction, u);
+
+    float radius = mix(aStartRadius.w, aEndRadius.w, aPos.z);
+    vec3 position = aStartRadius.xyz + aPos.z * axis + radius * (aPos.x * u + aPos.y * v);
+    gl_Position = projection * view * model * vec4(position, 1.0);
+    actualColor = aColor;
+}
\ No newline at end of file
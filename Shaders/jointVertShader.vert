@@ -0,0 +1,18 @@
+#version 460 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec4 aCenterRadius;
+layout (location = 2) in vec3 aColor;
+
+out vec3 actualColor;
+
+uniform mat4 model;
+layout (std140, binding = 0) uniform Camera {
+    mat4 projection;
+    mat4 view;
+};
+
+void main() {
+    gl_Position = projection * view * model * vec4(aCenterRadius.xyz + aCenterRadius.w * aPos, 1.0);
+    actualColor = aColor;
+}
\ No newline at end of file
@@ -6,8 +6,10 @@ layout (location = 1) in vec3 aColor;
 out vec3 actualColor;
 
 uniform mat4 modelSkeleton;
-uniform mat4 view;
-uniform mat4 projection;
+layout (std140, binding = 0) uniform Camera {
+    mat4 projection;
+    mat4 view;
+};
 
 void main() {
     gl_Position = projection * view * modelSkeleton * vec4(aPos, 1.0);
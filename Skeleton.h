@@ -0,0 +1,83 @@
+#ifndef INC_3D_AVATAR_SKELETON_H
+#define INC_3D_AVATAR_SKELETON_H
+
+// Joint indices of the Kinect v2 body, in the order the MatLab export stores them
+enum JointType {
+    SPINE_BASE = 0,
+    SPINE_MID = 1,
+    NECK = 2,
+    HEAD = 3,
+    SHOULDER_LEFT = 4,
+    ELBOW_LEFT = 5,
+    WRIST_LEFT = 6,
+    HAND_LEFT = 7,
+    SHOULDER_RIGHT = 8,
+    ELBOW_RIGHT = 9,
+    WRIST_RIGHT = 10,
+    HAND_RIGHT = 11,
+    HIP_LEFT = 12,
+    KNEE_LEFT = 13,
+    ANKLE_LEFT = 14,
+    FOOT_LEFT = 15,
+    HIP_RIGHT = 16,
+    KNEE_RIGHT = 17,
+    ANKLE_RIGHT = 18,
+    FOOT_RIGHT = 19,
+    SPINE_SHOULDER = 20,
+    HAND_TIP_LEFT = 21,
+    THUMB_LEFT = 22,
+    HAND_TIP_RIGHT = 23,
+    THUMB_RIGHT = 24
+};
+
+// Parent of every joint in the bone hierarchy, rooted at the spine base (the thumbs hang off the wrists, as drawn)
+const int JOINT_PARENTS[] = {
+        -1,                 // SPINE_BASE
+        SPINE_BASE,         // SPINE_MID
+        SPINE_SHOULDER,     // NECK
+        NECK,               // HEAD
+        SPINE_SHOULDER,     // SHOULDER_LEFT
+        SHOULDER_LEFT,      // ELBOW_LEFT
+        ELBOW_LEFT,         // WRIST_LEFT
+        WRIST_LEFT,         // HAND_LEFT
+        SPINE_SHOULDER,     // SHOULDER_RIGHT
+        SHOULDER_RIGHT,     // ELBOW_RIGHT
+        ELBOW_RIGHT,        // WRIST_RIGHT
+        WRIST_RIGHT,        // HAND_RIGHT
+        SPINE_BASE,         // HIP_LEFT
+        HIP_LEFT,           // KNEE_LEFT
+        KNEE_LEFT,          // ANKLE_LEFT
+        ANKLE_LEFT,         // FOOT_LEFT
+        SPINE_BASE,         // HIP_RIGHT
+        HIP_RIGHT,          // KNEE_RIGHT
+        KNEE_RIGHT,         // ANKLE_RIGHT
+        ANKLE_RIGHT,        // FOOT_RIGHT
+        SPINE_MID,          // SPINE_SHOULDER
+        HAND_LEFT,          // HAND_TIP_LEFT
+        WRIST_LEFT,         // THUMB_LEFT
+        HAND_RIGHT,         // HAND_TIP_RIGHT
+        WRIST_RIGHT         // THUMB_RIGHT
+};
+
+// The joints ordered from the root down, so every parent comes before its children
+const int JOINT_HIERARCHY_ORDER[] = {
+        SPINE_BASE, SPINE_MID, SPINE_SHOULDER, NECK, HEAD,
+        SHOULDER_LEFT, ELBOW_LEFT, WRIST_LEFT, HAND_LEFT, HAND_TIP_LEFT, THUMB_LEFT,
+        SHOULDER_RIGHT, ELBOW_RIGHT, WRIST_RIGHT, HAND_RIGHT, HAND_TIP_RIGHT, THUMB_RIGHT,
+        HIP_LEFT, KNEE_LEFT, ANKLE_LEFT, FOOT_LEFT,
+        HIP_RIGHT, KNEE_RIGHT, ANKLE_RIGHT, FOOT_RIGHT
+};
+
+// The pelvis and the legs: everything else is the upper body
+inline bool isLowerBody(int joint) {
+    return joint == SPINE_BASE || (joint >= HIP_LEFT && joint <= FOOT_RIGHT);
+}
+
+// The wrists, hands, hand tips and thumbs, which move much faster than the rest of the body
+inline bool isHand(int joint) {
+    return joint == WRIST_LEFT || joint == HAND_LEFT || joint == WRIST_RIGHT || joint == HAND_RIGHT ||
+           joint >= HAND_TIP_LEFT;
+}
+
+
+#endif //INC_3D_AVATAR_SKELETON_H
@@ -0,0 +1,70 @@
+#include "SkeletonLines.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+SkeletonLines::SkeletonLines(int numJoints, const unsigned int* indices, int numIndices)
+        : vertexBuffer(6 * numJoints * sizeof(float)) {
+
+    this->numJoints = numJoints;
+    this->numIndices = numIndices;
+
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer.getBuffer());
+
+    glGenBuffers(1, &EBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, numIndices * sizeof(unsigned int), indices, GL_STATIC_DRAW);
+
+    // position
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), nullptr);
+    glEnableVertexAttribArray(0);
+
+    // color
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    glBindVertexArray(0);
+
+}
+
+SkeletonLines::~SkeletonLines() {
+
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &EBO);
+
+}
+
+void SkeletonLines::update(const std::vector<Joint*>& joints, const glm::vec3& color) {
+
+    // This kind of offsets were the fastest way to get a constant translation in the middle of the grid
+    float* vertices = (float*)vertexBuffer.begin();
+    for(int i = 0; i < numJoints; i++) {
+        float* vertex = vertices + 6 * i;
+        vertex[0] = joints[i]->getX() + 6;
+        vertex[1] = joints[i]->getY();
+        vertex[2] = joints[i]->getZ() + 2;
+        vertex[3] = color.x;
+        vertex[4] = color.y;
+        vertex[5] = color.z;
+    }
+
+}
+
+void SkeletonLines::draw(Shader* shader, float lineWidth) {
+
+    shader->use();
+
+    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::translate(model, glm::vec3(-12.25f, 0.0f, -12.25f));
+    shader->setMat4("model", model);
+
+    glLineWidth(lineWidth);
+    glBindVertexArray(VAO);
+    glDrawElementsBaseVertex(GL_LINES, numIndices, GL_UNSIGNED_INT, nullptr,
+                             (GLint)(vertexBuffer.getOffset() / (6 * sizeof(float))));
+    glBindVertexArray(0);
+    vertexBuffer.end();
+
+}
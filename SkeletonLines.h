@@ -0,0 +1,45 @@
+#ifndef INC_3D_AVATAR_SKELETONLINES_H
+#define INC_3D_AVATAR_SKELETONLINES_H
+
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "Joint.h"
+#include "Shader.h"
+#include "StreamingBuffer.h"
+
+// The line overlay of the skeleton. Its vertex array and buffers are created once: every frame only the joint
+// positions are written, into the next region of a streaming buffer.
+class SkeletonLines {
+
+private:
+
+    unsigned int VAO, EBO;
+    // position and colour of every joint
+    StreamingBuffer vertexBuffer;
+    int numJoints;
+    int numIndices;
+
+public:
+
+    // A line between every pair of joints in indices
+    SkeletonLines(int numJoints, const unsigned int* indices, int numIndices);
+
+    ~SkeletonLines();
+
+    SkeletonLines(const SkeletonLines&) = delete;
+
+    SkeletonLines& operator=(const SkeletonLines&) = delete;
+
+    // Writes the current joint positions, for the next draw
+    void update(const std::vector<Joint*>& joints, const glm::vec3& color);
+
+    // Draws the lines with a shader taking the vertexShader.vert inputs
+    void draw(Shader* shader, float lineWidth);
+
+};
+
+
+#endif //INC_3D_AVATAR_SKELETONLINES_H
@@ -0,0 +1,72 @@
+#include "StreamingBuffer.h"
+
+#include <iostream>
+
+// how long to wait for a fence at a time, in nanoseconds
+const GLuint64 FENCE_TIMEOUT = 1000000000;
+
+StreamingBuffer::StreamingBuffer(size_t regionSize) {
+
+    this->regionSize = regionSize;
+    region = STREAMING_REGIONS - 1;
+    for(GLsync& fence : fences) {
+        fence = nullptr;
+    }
+
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferStorage(GL_ARRAY_BUFFER, STREAMING_REGIONS * regionSize, nullptr, flags);
+    mapped = (char*)glMapBufferRange(GL_ARRAY_BUFFER, 0, STREAMING_REGIONS * regionSize, flags);
+
+    if(mapped == nullptr) {
+        std::cout << "ERROR::STREAMING_BUFFER::MAP_FAILED" << std::endl;
+    }
+
+}
+
+StreamingBuffer::~StreamingBuffer() {
+
+    for(GLsync fence : fences) {
+        if(fence != nullptr) {
+            glDeleteSync(fence);
+        }
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    glDeleteBuffers(1, &buffer);
+
+}
+
+unsigned int StreamingBuffer::getBuffer() const {
+    return buffer;
+}
+
+void* StreamingBuffer::begin() {
+
+    region = (region + 1) % STREAMING_REGIONS;
+
+    GLsync& fence = fences[region];
+    if(fence != nullptr) {
+        GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT);
+        while(status == GL_TIMEOUT_EXPIRED) {
+            status = glClientWaitSync(fence, 0, FENCE_TIMEOUT);
+        }
+        if(status == GL_WAIT_FAILED) {
+            std::cout << "ERROR::STREAMING_BUFFER::WAIT_FAILED" << std::endl;
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    return mapped + region * regionSize;
+
+}
+
+size_t StreamingBuffer::getOffset() const {
+    return region * regionSize;
+}
+
+void StreamingBuffer::end() {
+    fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
@@ -0,0 +1,49 @@
+#ifndef INC_3D_AVATAR_STREAMINGBUFFER_H
+#define INC_3D_AVATAR_STREAMINGBUFFER_H
+
+#include <cstddef>
+
+#include <glad/glad.h>
+
+// one region being written by the CPU, one queued and one being read by the GPU
+const int STREAMING_REGIONS = 3;
+
+// A vertex buffer for the data that changes every frame. Its storage is allocated once and stays mapped (persistent
+// and coherent), split into STREAMING_REGIONS regions used in turn: the data of a frame is written straight into the
+// mapped memory, and a fence placed after the draws reading a region keeps it from being overwritten until the GPU
+// is done with it.
+class StreamingBuffer {
+
+private:
+
+    unsigned int buffer;
+    char* mapped;
+    size_t regionSize;
+    int region;
+    GLsync fences[STREAMING_REGIONS];
+
+public:
+
+    explicit StreamingBuffer(size_t regionSize);
+
+    ~StreamingBuffer();
+
+    StreamingBuffer(const StreamingBuffer&) = delete;
+
+    StreamingBuffer& operator=(const StreamingBuffer&) = delete;
+
+    unsigned int getBuffer() const;
+
+    // Moves to the next region, waiting for the GPU to be done with it, and returns where to write its regionSize bytes
+    void* begin();
+
+    // Offset of the current region in the buffer, in bytes: the draws use it as their base vertex or instance
+    size_t getOffset() const;
+
+    // Called once the draws reading the current region have been issued
+    void end();
+
+};
+
+
+#endif //INC_3D_AVATAR_STREAMINGBUFFER_H
@@ -0,0 +1,120 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+// index of the pool worker running on this thread, -1 outside of the pool
+static thread_local int currentWorker = -1;
+static thread_local const ThreadPool* currentPool = nullptr;
+
+ThreadPool::ThreadPool(int numThreads) : pending(0), queued(0), nextWorker(0), stopping(false) {
+
+    if(numThreads <= 0) {
+        numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+
+    for(int i = 0; i < numThreads; i++) {
+        workers.emplace_back(new Worker());
+    }
+    for(int i = 0; i < numThreads; i++) {
+        threads.emplace_back(&ThreadPool::run, this, i);
+    }
+
+}
+
+ThreadPool::~ThreadPool() {
+
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for(auto& thread : threads) {
+        thread.join();
+    }
+
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+
+    int index = currentPool == this ? currentWorker : (int)(nextWorker++ % workers.size());
+    pending++;
+    {
+        std::lock_guard<std::mutex> lock(workers[index]->mutex);
+        workers[index]->tasks.push_back(std::move(task));
+        queued++;
+    }
+    {
+        // taking the lock makes sure a worker about to sleep sees the new task
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wakeUp.notify_one();
+
+}
+
+bool ThreadPool::popTask(int index, std::function<void()>& task) {
+
+    {
+        Worker& own = *workers[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if(!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued--;
+            return true;
+        }
+    }
+
+    for(size_t i = 1; i < workers.size(); i++) {
+        Worker& victim = *workers[(index + i) % workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if(!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued--;
+            return true;
+        }
+    }
+
+    return false;
+
+}
+
+void ThreadPool::run(int index) {
+
+    currentWorker = index;
+    currentPool = this;
+    std::function<void()> task;
+
+    while(true) {
+
+        if(popTask(index, task)) {
+            task();
+            task = nullptr;
+            if(--pending == 0) {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+                allDone.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        if(stopping) {
+            return;
+        }
+        wakeUp.wait(lock, [this] { return stopping || queued > 0; });
+
+    }
+
+}
+
+void ThreadPool::wait() {
+
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    allDone.wait(lock, [this] { return pending == 0; });
+
+}
+
+int ThreadPool::getNumThreads() const {
+    return (int)threads.size();
+}
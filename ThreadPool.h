@@ -0,0 +1,62 @@
+#ifndef INC_3D_AVATAR_THREADPOOL_H
+#define INC_3D_AVATAR_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A work-stealing thread pool: every worker has its own task queue, takes its newest task first and, when it runs out
+// of work, steals the oldest task of another worker. Tasks submitted from inside a task go to the current worker's
+// queue, so a big job can split itself into pieces that idle workers pick up.
+class ThreadPool {
+
+private:
+
+    struct Worker {
+        std::deque<std::function<void()>> tasks;
+        std::mutex mutex;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    // tasks submitted and not finished yet, and those of them still waiting in a queue
+    std::atomic<int> pending;
+    std::atomic<int> queued;
+    std::atomic<unsigned int> nextWorker;
+    bool stopping;
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::condition_variable allDone;
+
+    bool popTask(int index, std::function<void()>& task);
+
+    void run(int index);
+
+public:
+
+    // numThreads = 0 uses one thread per hardware core
+    explicit ThreadPool(int numThreads = 0);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+
+    // Blocks until every submitted task, including those submitted by other tasks, has finished
+    void wait();
+
+    int getNumThreads() const;
+
+};
+
+
+#endif //INC_3D_AVATAR_THREADPOOL_H
@@ -0,0 +1,162 @@
+#include "ZeroPhaseFilter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <memory>
+
+// samples of reflection padded at each end: three times the length of the filter, as filtfilt does
+const int FILTER_PADDING = 9;
+
+const float FILTER_PI = 3.14159265f;
+
+// Runs the filter over samples in place, starting from the steady state of a constant input equal to the first one
+static void runFilter(float* samples, int length, const float* b, const float* a) {
+
+    // transposed direct form II, whose state for a constant input x (unit DC gain) is z1 = (1 - b0) x, z2 = (b2 - a2) x
+    float z1 = (1 - b[0]) * samples[0];
+    float z2 = (b[2] - a[2]) * samples[0];
+    for(int i = 0; i < length; i++) {
+        float x = samples[i];
+        float y = b[0] * x + z1;
+        z1 = b[1] * x - a[1] * y + z2;
+        z2 = b[2] * x - a[2] * y;
+        samples[i] = y;
+    }
+
+}
+
+float getFilterCutoff(float cutoff, float rate) {
+    return std::min(cutoff, MAX_CUTOFF_FRACTION * rate);
+}
+
+void filterTrack(float* track, int length, float cutoff, float rate) {
+
+    if(length < 2) {
+        return;
+    }
+    cutoff = getFilterCutoff(cutoff, rate);
+
+    // second order Butterworth low-pass by the bilinear transform
+    float k = std::tan(FILTER_PI * cutoff / rate);
+    float norm = 1 / (1 + std::sqrt(2.0f) * k + k * k);
+    float b[3] = {k * k * norm, 2 * k * k * norm, k * k * norm};
+    float a[3] = {1.0f, 2 * (k * k - 1) * norm, (1 - std::sqrt(2.0f) * k + k * k) * norm};
+
+    int padding = std::min(FILTER_PADDING, length - 1);
+    std::vector<float> padded(length + 2 * padding);
+    for(int i = 0; i < padding; i++) {
+        padded[padding - 1 - i] = 2 * track[0] - track[i + 1];
+        padded[padding + length + i] = 2 * track[length - 1] - track[length - 2 - i];
+    }
+    std::copy(track, track + length, padded.begin() + padding);
+
+    runFilter(padded.data(), (int)padded.size(), b, a);
+    std::reverse(padded.begin(), padded.end());
+    runFilter(padded.data(), (int)padded.size(), b, a);
+    std::reverse(padded.begin(), padded.end());
+
+    std::copy(padded.begin() + padding, padded.begin() + padding + length, track);
+
+}
+
+// The state shared by the channels of a clip being filtered: the positions as 75 contiguous tracks. The last
+// channel to finish copies them back into the clip and calls onDone.
+struct FilterTask {
+
+    Clip clip;
+    std::vector<float> tracks;
+    std::atomic<int> remainingChannels;
+    std::function<void(FilterTask&)> onDone;
+
+    FilterTask() : remainingChannels(0) {}
+
+};
+
+static void runFilterTask(ThreadPool& pool, const std::shared_ptr<FilterTask>& task, float cutoff) {
+
+    Clip& clip = task->clip;
+    int numFrames = clip.getNumFrames();
+    if(numFrames < 2) {
+        task->onDone(*task);
+        return;
+    }
+    float rate = (numFrames - 1) / clip.getDuration();
+    if(getFilterCutoff(cutoff, rate) < cutoff) {
+        std::cout << "WARNING::FILTER::CUTOFF_ABOVE_NYQUIST " << cutoff << " Hz at " << rate << " keys per second, "
+                  << "filtering at " << getFilterCutoff(cutoff, rate) << " Hz" << std::endl;
+    }
+
+    task->tracks.resize((size_t)NUM_CHANNELS * numFrames);
+    for(int i = 0; i < numFrames; i++) {
+        const float* frame = clip.getFrame(i);
+        for(int c = 0; c < NUM_CHANNELS; c++) {
+            task->tracks[(size_t)c * numFrames + i] = frame[c];
+        }
+    }
+
+    task->remainingChannels = NUM_CHANNELS;
+    for(int c = 0; c < NUM_CHANNELS; c++) {
+        pool.submit([task, c, numFrames, cutoff, rate] {
+            filterTrack(task->tracks.data() + (size_t)c * numFrames, numFrames, cutoff, rate);
+            if(--task->remainingChannels > 0) {
+                return;
+            }
+            for(int i = 0; i < numFrames; i++) {
+                float* frame = task->clip.getFrame(i);
+                for(int channel = 0; channel < NUM_CHANNELS; channel++) {
+                    frame[channel] = task->tracks[(size_t)channel * numFrames + i];
+                }
+            }
+            task->onDone(*task);
+        });
+    }
+
+}
+
+void filterClip(Clip& clip, float cutoff, ThreadPool& pool) {
+
+    auto task = std::make_shared<FilterTask>();
+    task->clip = std::move(clip);
+    task->onDone = [&clip](FilterTask& done) {
+        clip = std::move(done.clip);
+    };
+    runFilterTask(pool, task, cutoff);
+    pool.wait();
+
+}
+
+BatchStatistics filterRecordings(const std::vector<std::string>& fileNames, const std::string& outputDirectory,
+                                 float cutoff, ThreadPool& pool) {
+
+    std::atomic<int> numClips(0);
+    std::atomic<long> numFrames(0);
+    auto start = std::chrono::steady_clock::now();
+
+    for(const std::string& fileName : fileNames) {
+        std::string outputName = outputDirectory + "/" + getBaseName(fileName);
+        pool.submit([&pool, &numClips, &numFrames, fileName, outputName, cutoff] {
+            auto task = std::make_shared<FilterTask>();
+            task->clip = getJointClip(fileName);
+            // a missing or unreadable file loads as an empty clip: it is reported and skipped, not written
+            if(task->clip.getNumFrames() == 0) {
+                std::cout << "ERROR::FILTER::EMPTY_RECORDING " << fileName << std::endl;
+                return;
+            }
+            task->onDone = [&numClips, &numFrames, outputName](FilterTask& done) {
+                writeJointClip(outputName, done.clip);
+                numClips++;
+                numFrames += done.clip.getNumFrames();
+            };
+            runFilterTask(pool, task, cutoff);
+        });
+    }
+    pool.wait();
+
+    return {numClips.load(), numFrames.load(),
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+
+}
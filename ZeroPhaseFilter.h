@@ -0,0 +1,39 @@
+#ifndef INC_3D_AVATAR_ZEROPHASEFILTER_H
+#define INC_3D_AVATAR_ZEROPHASEFILTER_H
+
+#include <string>
+#include <vector>
+
+#include "BatchResampler.h"
+#include "Clip.h"
+#include "ThreadPool.h"
+
+// The usual cutoff for human motion capture: faster than any voluntary movement, slower than the sensor noise
+const float DEFAULT_SMOOTHING_CUTOFF = 6.0f;
+
+// Highest cutoff, as a fraction of the sample rate: just below the Nyquist frequency (0.5), where the filter breaks
+// down. Recordings without timestamps are taken at 6 keys per second, where it is 2.4 Hz.
+const float MAX_CUTOFF_FRACTION = 0.4f;
+
+// Low-passes a track of length evenly spaced samples in place with a second order Butterworth filter run forwards
+// and then backwards, which cancels its phase lag. The ends are padded with a point reflection of the track and the
+// filter starts in its steady state, so they don't ring. The cutoff is clamped below the Nyquist frequency (see
+// getFilterCutoff()).
+void filterTrack(float* track, int length, float cutoff, float rate);
+
+// The cutoff a filter at that sample rate can actually use: at most MAX_CUTOFF_FRACTION of the rate
+float getFilterCutoff(float cutoff, float rate);
+
+// Filters the 75 position channels of a clip, each as a contiguous track, in parallel on the pool. The keys are
+// taken as evenly spaced at the clip's mean key rate; the orientations and tracking states are kept. A cutoff too
+// high for that rate is clamped, with a warning.
+void filterClip(Clip& clip, float cutoff, ThreadPool& pool);
+
+// Filters every recording on the pool, across the clips and across their channels, writing each result in
+// outputDirectory under the same file name. Recordings that are missing or have no frames are reported and left out
+// of the statistics.
+BatchStatistics filterRecordings(const std::vector<std::string>& fileNames, const std::string& outputDirectory,
+                                 float cutoff, ThreadPool& pool);
+
+
+#endif //INC_3D_AVATAR_ZEROPHASEFILTER_H
@@ -27,6 +27,23 @@
 #include "Shader.h"
 #include "Camera.h"
 #include "Position.h"
+#include "Clip.h"
+#include "ClipSampler.h"
+#include "Benchmarks.h"
+#include "BatchResampler.h"
+#include "PlaybackController.h"
+#include "BlendEngine.h"
+#include "KeyframeReducer.h"
+#include "PosePredictor.h"
+#include "ZeroPhaseFilter.h"
+#include "FramePipeline.h"
+#include "FrameStages.h"
+#include "FrameClock.h"
+#include "JointRenderer.h"
+#include "BoneRenderer.h"
+#include "CameraUniforms.h"
+#include "Grid.h"
+#include "SkeletonLines.h"
 #include "utils.h"
 
 #define PI 3.141592653
@@ -35,21 +52,14 @@ void framebufferSizeCallback(GLFWwindow* window, int width, int height);
 void processInput(GLFWwindow* window);
 void mouseCallback(GLFWwindow* window, double posX, double posY);
 void scrollCallback(GLFWwindow* window, double offsetX, double offsetY);
+void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
 
 // drawing functions
-void drawGrid(Shader* shader, unsigned int gridVAO, unsigned int gridEBO, int numVertices);
 void drawCoordSystem(Shader* shader, unsigned int coordVAO, unsigned int coordEBO, int numVertices);
-void drawSkeleton(Shader* shader, std::vector<Position*> allInterPos, int skeletonFrame, std::vector<float> colorRGB);
-void drawSkeletonRealtime(Shader* shader, std::vector<Joint*> joints, std::vector<float> colorRGB);
-void drawSphere(std::vector<GLfloat> color, std::vector<GLdouble> position, float radius);
-void drawCube(std::vector<GLfloat> color, std::vector<GLdouble> position, float side);
-void drawCylinder(float pHeight, std::vector<float> center1, std::vector<float> center2, float bRadius, float tRadius,
-        std::vector<float> color);
 
 // data management functions
-std::vector<Position*> getJointPositions(std::string fileName);
-std::vector<Position*> getJointPositionsRealtime(std::string fileName);
-std::vector<Position*> interpolate(Position* start, Position* end, int times);
+void setJoints(std::vector<Joint*> &joints, const float* pose);
+int countGLObjects();
 
 // Window settings
 const unsigned int WIN_WIDTH = 1920;
@@ -62,14 +72,18 @@ double lastY = (float)WIN_HEIGHT / 2;
 bool firstMouse = true;
 float fov = 45.0f;
 
+// Ground grid: the length of its sides and the distance between its lines
+const float GRID_EXTENT = 12.5f;
+const float GRID_SPACING = 0.25f;
+
 // Time handling
 float deltaTime = 0.0f;
 float lastFrame = 0.0f;
 
-// a one-position buffer in case the MatLab KinectJointsRealtime.csv file is empty, used to make the skeleton stable.
-Position* lastKnownPos;
-int skeletonFrame = 0;
-GLUquadricObj* quadric = gluNewQuadric();
+// playback position, speed and direction inside the recorded clip
+PlaybackController playback;
+// clip seconds scrubbed per pixel of horizontal mouse movement, while the left button is held
+const double SCRUB_SECONDS_PER_PIXEL = 0.01;
 unsigned int skeletonIndices[] = {
 
         3, 2,        // HEAD - NECK
@@ -104,40 +118,137 @@ unsigned int skeletonIndices[] = {
 
 };
 
+// the 24 bones of skeletonIndices, then the two sides of the torso: SHOULDER_RIGHT - HIP_RIGHT and
+// SHOULDER_LEFT - HIP_LEFT
+const int NUM_BONES = 26;
+
 // a flag to decide whether to get realtime data or not
 bool realtime = false;
+// a flag to layer the live upper body over the recorded lower body, when not in realtime mode
+bool blendLiveUpperBody = false;
 
 int main(int argcp, char **argv) {
 
-    std::vector<Position*>allInterPos;
+    // usage: 3D_avatar --resample <frames per second> <output directory> <recordings...>
+    if(argcp >= 5 && std::string(argv[1]) == "--resample") {
+        ThreadPool pool;
+        std::vector<std::string> recordings(argv + 4, argv + argcp);
+        BatchStatistics statistics = resampleRecordings(recordings, argv[3], std::stof(argv[2]), pool);
+        std::cout << "Resampled " << statistics.numClips << " clips (" << statistics.numFrames << " frames) in "
+                  << statistics.seconds << " s on " << pool.getNumThreads() << " threads: "
+                  << statistics.numFrames / statistics.seconds << " frames per second" << std::endl;
+        return 0;
+    }
+
+    // usage: 3D_avatar --smooth <cutoff frequency> <output directory> <recordings...>
+    if(argcp >= 5 && std::string(argv[1]) == "--smooth") {
+        ThreadPool pool;
+        std::vector<std::string> recordings(argv + 4, argv + argcp);
+        BatchStatistics statistics = filterRecordings(recordings, argv[3], std::stof(argv[2]), pool);
+        std::cout << "Smoothed " << statistics.numClips << " clips (" << statistics.numFrames << " frames) in "
+                  << statistics.seconds << " s on " << pool.getNumThreads() << " threads" << std::endl;
+        return 0;
+    }
+
+    // The recorded clip only stores the key poses: every rendered (or exported) pose is sampled from it on demand
+    Clip clip;
+    ClipSampler sampler(&clip);
+    float pose[NUM_CHANNELS];
     std::vector<Joint*> joints;
+    for(int i = 0; i < NUM_JOINTS; i++) {
+        joints.push_back(new Joint(3, 3, 3));
+    }
+
+    // a one-frame buffer in case the MatLab KinectJointsRealtime.csv file is empty, used to make the skeleton stable.
+    // Only new frames go through the live processing: the file is read much more often than the sensor writes it.
+    BodyFrame liveFrame = {};
+    std::fill(liveFrame.positions, liveFrame.positions + NUM_CHANNELS, 3.0f);
+    float liveRawPositions[NUM_CHANNELS] = {};
+    // repairs, filters and constrains the recording and the live frames (the stages are set in pipeline.cfg)
+    FramePipeline pipeline = loadPipeline("../pipeline.cfg");
+    auto updateLiveFrame = [&]() {
+        Clip liveClip = getJointClip("../KinectJointsRealtime.csv");
+        if(liveClip.getNumFrames() > 0 &&
+           !std::equal(liveRawPositions, liveRawPositions + NUM_CHANNELS, liveClip.getFrame(0))) {
+            std::copy(liveClip.getFrame(0), liveClip.getFrame(0) + NUM_CHANNELS, liveRawPositions);
+            BodyFrame frame;
+            liveClip.getBodyFrame(0, frame);
+            frame.time = glfwGetTime();
+            // a dropped frame leaves the last good one on screen
+            if(pipeline.process(frame)) {
+                liveFrame = frame;
+            }
+        }
+    };
+
+    float lowerBodyMask[NUM_JOINTS];
+    float upperBodyMask[NUM_JOINTS];
+    fillBodyMask(lowerBodyMask, true);
+    fillBodyMask(upperBodyMask, false);
+    float livePose[NUM_CHANNELS];
+
     if(!realtime) {
-        std::vector<Position *> positions = getJointPositions("../KinectJoints.csv");
-
-        // Smoothing the animation
-        int times = 10;
-        int currentPos = 0;
-        for(int i = 0; i < positions.size() - 1; i++) {
-            std::cout << "interpolating between positions " << currentPos << " and " << currentPos + 1 << std::endl;
-            std::vector<Position*> interPositions = interpolate(positions[i], positions[i + 1], times);
-            for(auto itr = interPositions.begin(); itr != interPositions.end(); itr++) {
-                allInterPos.push_back(*itr);
+        // the command line tools work on the recording as it was captured, before the pipeline touches it
+        clip = getJointClip("../KinectJoints.csv");
+        sampler.update();
+        std::cout << "Current number of key frames: " << clip.getNumFrames() << std::endl;
+
+        if(argcp == 2 && std::string(argv[1]) == "--benchmark") {
+            runBenchmarks(clip);
+            return 0;
+        }
+
+        // usage: 3D_avatar --evaluate-prediction
+        if(argcp == 2 && std::string(argv[1]) == "--evaluate-prediction") {
+            // each prediction is scored against the first recorded frame at least the horizon ahead: a horizon
+            // shorter than the key spacing would be scored further ahead than it predicts
+            float keySpacing = clip.getNumFrames() > 1 ? clip.getDuration() / (clip.getNumFrames() - 1) : 0.0f;
+            for(float horizon : {0.02f, 0.03f, 0.04f, 0.05f, 0.1f, 0.2f, 0.5f}) {
+                if(horizon < keySpacing) {
+                    std::cout << horizon * 1000 << " ms ahead: skipped, shorter than the " << keySpacing * 1000
+                              << " ms between keys" << std::endl;
+                    continue;
+                }
+                for(float accelerationWeight : {0.0f, DEFAULT_PREDICTION.accelerationWeight, 1.0f}) {
+                    PredictionSettings settings = DEFAULT_PREDICTION;
+                    settings.horizon = horizon;
+                    settings.accelerationWeight = accelerationWeight;
+                    PredictionError error = evaluatePrediction(clip, settings);
+                    std::cout << error.meanOffset * 1000 << " ms ahead (horizon " << horizon * 1000
+                              << " ms), acceleration weight " << accelerationWeight << ": " << error.meanError * 1000
+                              << " mm mean, " << error.maxError * 1000 << " mm max error ("
+                              << error.meanHoldError * 1000 << " mm mean, " << error.maxHoldError * 1000
+                              << " mm max without prediction)" << std::endl;
+                }
             }
-            currentPos++;
+            return 0;
         }
 
-        std::cout << "Current number of frames: " << allInterPos.size() << std::endl;
+        // usage: 3D_avatar --reduce <output.csv> <tolerance in metres>
+        if(argcp == 4 && std::string(argv[1]) == "--reduce") {
+            Clip reduced = reduceKeyframes(clip, CLIP_SCALE * std::stof(argv[3]));
+            std::cout << "Kept " << reduced.getNumFrames() << " of " << clip.getNumFrames() << " keys, max error "
+                      << getReconstructionError(clip, reduced, SAMPLE_CATMULL_ROM) / CLIP_SCALE * 1000 << " mm"
+                      << std::endl;
+            writeJointClip(argv[2], reduced);
+            return 0;
+        }
 
-        // since the allInterPos vector contains >> positions than positions, the animation is more fluid even without
-        // re-assignment
-        joints = allInterPos[skeletonFrame]->getJoints();
-    }
+        // usage: 3D_avatar --export <output.csv> <frames per second>
+        if(argcp == 4 && std::string(argv[1]) == "--export") {
+            writeJointClip(argv[2], sampler.resample(std::stof(argv[3])));
+            return 0;
+        }
 
-    std::vector<Joint*> startingPos;
-    for(int i = 0; i < 25; i++) {
-        startingPos.push_back(new Joint(3, 3, 3));
+        pipeline.processClip(clip);
+        pipeline.printStatistics(std::cout);
+        pipeline.resetStatistics();
+        sampler.update();
+
+        playback.setDuration(clip.getDuration());
+        sampler.sample(clip.getTime(0), pose);
+        setJoints(joints, pose);
     }
-    lastKnownPos = new Position(startingPos);
 
     glutInit(&argcp, argv);
     glfwInit();
@@ -154,9 +265,14 @@ int main(int argcp, char **argv) {
     }
 
     glfwMakeContextCurrent(window);
+    // the animation is sampled at the times the frames reach the screen, so we wait for every refresh
+    glfwSwapInterval(1);
+    const GLFWvidmode* videoMode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+    FrameClock frameClock(videoMode ? videoMode->refreshRate : 60);
     glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
     glfwSetCursorPosCallback(window, mouseCallback);
     glfwSetScrollCallback(window, scrollCallback);
+    glfwSetKeyCallback(window, keyCallback);
 
     if(!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
         std::cout << "Failed to initialize GLAD." << std::endl;
@@ -170,22 +286,6 @@ int main(int argcp, char **argv) {
 
     float currentFrame;
 
-    float gridVertices[] = {
-
-            // position          // color
-            0.0f, 0.0f, 0.0f,    1.0f, 1.0f, 1.0f,
-            0.25f, 0.0f, 0.0f,    1.0f, 1.0f, 1.0f,
-            0.25f, 0.0f, 0.25f,    1.0f, 1.0f, 1.0f,
-            0.0f, 0.0f, 0.25f,    1.0f, 1.0f, 1.0f
-
-    };
-
-    unsigned int gridIndices[] = {
-
-            0, 1, 2, 3
-
-    };
-
     float coordSystemVertices[] = {
 
             -1.0f, 0.0f, 0.0f,    0.0f, 0.0f, 1.0f,    // X-axis -- BLUE
@@ -222,27 +322,18 @@ int main(int argcp, char **argv) {
 
     };
 
-    // --------------------- GRID ------------------------------
+    // ------------------------ CAMERA -------------------------
 
-    unsigned int gridVAO, gridVBO, gridEBO;
-    glGenVertexArrays(1, &gridVAO);
-    glBindVertexArray(gridVAO);
+    CameraUniforms* cameraUniforms = new CameraUniforms();
 
-    glGenBuffers(1, &gridVBO);
-    glBindBuffer(GL_ARRAY_BUFFER, gridVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(gridVertices), gridVertices, GL_STATIC_DRAW);
+    // --------------------- GRID ------------------------------
 
-    glGenBuffers(1, &gridEBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gridEBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(gridIndices), gridIndices, GL_STATIC_DRAW);
+    Grid* grid = new Grid(glm::vec3(-12.25f, 0.0f, -12.25f), GRID_EXTENT, GRID_SPACING);
 
-    // position
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_TRUE, 6 * sizeof(float), nullptr);
-    glEnableVertexAttribArray(0);
+    // -------------------- SKELETON LINES ----------------------
 
-    // color
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    SkeletonLines* skeletonLines = new SkeletonLines(NUM_JOINTS, skeletonIndices,
+                                                     sizeof(skeletonIndices) / sizeof(unsigned int));
 
     // ---------------------- COORDINATE SYSTEM ------------------------
 
@@ -268,20 +359,90 @@ int main(int argcp, char **argv) {
 
     glPointSize(15.0f);
 
-    double timerStart, timerEnd;
-    float distance, bRadius, tRadius;
-    std::vector<float> color;
+    // the spheres and the bones are moved into the middle of the grid, like the skeleton lines
+    glm::mat4 skeletonModel = glm::translate(glm::mat4(1.0f), glm::vec3(-12.25f, 0.0f, -12.25f));
+
+    // The joint spheres only change position: the head is larger, the wrists, hands and thumbs smaller, the neck
+    // and the middle of the spine have their own colours
+    JointRenderer* jointRenderer = new JointRenderer(NUM_JOINTS);
+    JointInstance jointInstances[NUM_JOINTS];
+    for(int i = 0; i < NUM_JOINTS; i++) {
+        bool hand = i == 6 || i == 7 || i == 10 || i == 11 || i == 21 || i == 22 || i == 23 || i == 24;
+        float blue[3] = {0.1f, 0.1f, 0.7f};
+        float green[3] = {0.0f, 1.0f, 0.0f};
+        float yellow[3] = {1.0f, 1.0f, 0.0f};
+        const float* color = i == 1 ? green : (i == 2 ? yellow : blue);
+        jointInstances[i].radius = i == 3 ? 0.3f : (hand ? 0.075f : (i == 1 || i == 2 ? 0.1f : 0.15f));
+        std::copy(color, color + 3, jointInstances[i].color);
+    }
+
+    // The bones go from the child joint to the parent one (the two torso sides close the trunk): the forearms and
+    // the legs are tapered, the trunk is green
+    BoneRenderer* boneRenderer = new BoneRenderer(NUM_BONES);
+    BoneInstance boneInstances[NUM_BONES];
+    int boneJoints[NUM_BONES][2];
+    for(int b = 0; b < NUM_BONES; b++) {
+        int child = b < 24 ? skeletonIndices[2 * b + 1] : (b == 24 ? 16 : 12);
+        int parent = b < 24 ? skeletonIndices[2 * b] : (b == 24 ? 8 : 4);
+        boneJoints[b][0] = child;
+        boneJoints[b][1] = parent;
+
+        float startRadius = 0.1f, endRadius = 0.1f;
+        if(child == 6 || child == 10) {
+            startRadius = 0.05f;
+        }
+        else if(child == 7 || child == 11 || child == 21 || child == 22 || child == 23 || child == 24) {
+            startRadius = 0.05f;
+            endRadius = 0.05f;
+        }
+        else if(child == 13 || child == 17) {
+            startRadius = 0.115f;
+            endRadius = 0.15f;
+        }
+        else if(child == 14 || child == 18) {
+            startRadius = 0.09f;
+            endRadius = 0.115f;
+        }
+        boneInstances[b].startRadius = startRadius;
+        boneInstances[b].endRadius = endRadius;
+
+        bool trunk = b >= 24 || child == 0 || child == 1 || child == 4 || child == 8 || child == 12 || child == 16;
+        float green[3] = {0.0f, 1.0f, 0.0f};
+        float yellow[3] = {1.0f, 1.0f, 0.0f};
+        std::copy(trunk ? green : yellow, (trunk ? green : yellow) + 3, boneInstances[b].color);
+    }
 
     glm::vec3 pos = camera.Position;
 
+    glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
+    int glObjects = -1;
+
     while(!glfwWindowShouldClose(window)) {
 
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        // NON REALTIME ANIMATION
+        currentFrame = (float) glfwGetTime();
+        deltaTime = currentFrame - lastFrame;
+        lastFrame = currentFrame;
+
+        processInput(window);
+
+        // NON REALTIME ANIMATION: the clip is sampled at the time this frame will be displayed, so that it plays at
+        // its own speed (and smoothly) whatever the refresh rate
         if(!realtime) {
-            timerStart = glfwGetTime();
-            joints = allInterPos[skeletonFrame % allInterPos.size()]->getJoints();
+            playback.update(frameClock.advance(glfwGetTime()));
+            sampler.sample(clip.getTime(0) + (float)playback.getTime(), pose);
+
+            // the live upper body is moved onto the recorded pelvis before being layered over the recording
+            if(blendLiveUpperBody) {
+                updateLiveFrame();
+                for(int c = 0; c < NUM_CHANNELS; c++) {
+                    livePose[c] = liveFrame.positions[c] - liveFrame.positions[c % 3] + pose[c % 3];
+                }
+                BlendSource sources[] = {{pose, 1.0f, lowerBodyMask}, {livePose, 1.0f, upperBodyMask}};
+                blendPoses(sources, 2, pose);
+            }
+            setJoints(joints, pose);
         }
 
 
@@ -289,123 +450,74 @@ int main(int argcp, char **argv) {
         // https://it.mathworks.com/matlabcentral/fileexchange/53439-kinect-2-interface-for-matlab
         // Just copy the videoDemo.m and videoDemoWithWindows.m scripts inside the project's folder and run one of them
         else {
-            std::vector<Position*> positionsRealtime = getJointPositionsRealtime("../KinectJointsRealtime.csv");
-            try {
-                joints = positionsRealtime[0]->getJoints();
-            }catch(std::exception &e) {
-                std::cout << "Exception caught: " << e.what() << std::endl;
-            }
+            updateLiveFrame();
+            setJoints(joints, liveFrame.positions);
         }
 
-        currentFrame = (float) glfwGetTime();
-        deltaTime = currentFrame - lastFrame;
-        lastFrame = currentFrame;
-
-        processInput(window);
+        // the camera matrices are computed once per frame, and every shader reads them from the same buffer
+        glm::mat4 projection = glm::perspective(glm::radians(fov), (float)WIN_WIDTH / (float)WIN_HEIGHT, 0.1f, 100.0f);
+        cameraUniforms->update(projection, camera.GetViewMatrix());
 
-        drawGrid(&shader, gridVAO, gridEBO, sizeof(gridIndices));
+        grid->draw(&shader);
 
-        // Since we need a bunch of different spheres (depending on the joint we're using), we need to use this bad
-        // if-else statment...
-        for(int i = 0; i < joints.size(); i++) {
-            if(i != 1 && i != 2 && i != 3 && i != 22 && i != 24 && i != 11 && i != 7 && i != 21 && i != 23 && i != 6 && i != 10) {
-                drawSphere({0.1, 0.1, 0.7},
-                           {joints[i]->getX() + 6, joints[i]->getY() + (float) 2.5, joints[i]->getZ() + 2}, 0.15);
-            }
-            else if(i == 3) {
-                drawSphere({0.1, 0.1, 0.7},
-                           {joints[i]->getX() + 6, joints[i]->getY() + (float) 2.5, joints[i]->getZ() + 2}, 0.3);
-            }
-            else if(i == 22 || i == 24 || i == 11 || i == 7 || i == 21 || i == 23 || i == 6 || i == 10) {
-                drawSphere({0.1, 0.1, 0.7},
-                           {joints[i]->getX() + 6, joints[i]->getY() + (float) 2.5, joints[i]->getZ() + 2}, 0.075);
-            }
-            else if(i == 0 || i == 1) {
-                drawSphere({0.0, 1.0, 0.0},
-                           {joints[i]->getX() + 6, joints[i]->getY() + (float) 2.5, joints[i]->getZ() + 2}, 0.1);
-            }
-            else {
-                drawSphere({1.0, 1.0, 0.0},
-                           {joints[i]->getX() + 6, joints[i]->getY() + (float) 2.5, joints[i]->getZ() + 2}, 0.1);
-            }
+        // all the joint spheres in one draw call
+        for(int i = 0; i < NUM_JOINTS; i++) {
+            jointInstances[i].position[0] = joints[i]->getX() + 6;
+            jointInstances[i].position[1] = joints[i]->getY();
+            jointInstances[i].position[2] = joints[i]->getZ() + 2;
         }
-
-        // ... and the same goes for the cylinders
-        for(int j = 0; j < 48; j += 2) {
-            distance = (float)sqrt(pow(joints[skeletonIndices[j + 1]]->getX() - joints[skeletonIndices[j]]->getX(), 2) +
-                    pow(joints[skeletonIndices[j + 1]]->getY() - joints[skeletonIndices[j]]->getY(), 2) +
-                    pow(joints[skeletonIndices[j + 1]]->getZ() - joints[skeletonIndices[j]]->getZ(), 2));
-            if(skeletonIndices[j + 1] == 6 || skeletonIndices[j + 1] == 10) {
-                bRadius = 0.05f;
-                tRadius = 0.1f;
-            }
-            else if(skeletonIndices[j + 1] == 11 || skeletonIndices[j + 1] == 24 || skeletonIndices[j + 1] == 23 ||
-                    skeletonIndices[j + 1] == 7 || skeletonIndices[j + 1] == 21 || skeletonIndices[j + 1] == 22) {
-                bRadius = 0.05f;
-                tRadius = 0.05f;
-            }
-            else if(skeletonIndices[j + 1] == 17 || skeletonIndices[j + 1] == 13) {
-                bRadius = 0.115f;
-                tRadius = 0.15f;
-            }
-            else if(skeletonIndices[j + 1] == 14 || skeletonIndices[j + 1] == 18) {
-                bRadius = 0.09f;
-                tRadius = 0.115f;
-            }
-            else{
-                bRadius = 0.1f;
-                tRadius = 0.1f;
-            }
-            if(skeletonIndices[j + 1] == 4 || skeletonIndices[j + 1] == 8 || skeletonIndices[j + 1] == 12 ||
-                    skeletonIndices[j + 1] == 16 || skeletonIndices[j + 1] == 1 || skeletonIndices[j + 1] == 0) {
-                color = {0.0f, 1.0f, 0.0f};
-            }
-            else {
-                color = {1.0f, 1.0f, 0.0f};
-            }
-            drawCylinder(distance, joints[skeletonIndices[j]]->getCoordinates(), joints[skeletonIndices[j + 1]]->getCoordinates(),
-                    bRadius, tRadius, color);
-            distance = (float)sqrt(pow(joints[8]->getX() - joints[16]->getX(), 2) +
-                                  pow(joints[8]->getY() - joints[16]->getY(), 2) +
-                                  pow(joints[8]->getZ() - joints[16]->getZ(), 2));
-            drawCylinder(distance, joints[8]->getCoordinates(), joints[16]->getCoordinates(), 0.1f, 0.1f, {0.0f, 1.0f, 0.0f});
-            distance = (float)sqrt(pow(joints[4]->getX() - joints[12]->getX(), 2) +
-                                   pow(joints[4]->getY() - joints[12]->getY(), 2) +
-                                   pow(joints[4]->getZ() - joints[12]->getZ(), 2));
-            drawCylinder(distance, joints[4]->getCoordinates(), joints[12]->getCoordinates(), 0.1f, 0.1f, {0.0f, 1.0f, 0.0f});
+        jointRenderer->draw(jointInstances, NUM_JOINTS, skeletonModel);
+
+        // ... and all the bones in another one
+        for(int b = 0; b < NUM_BONES; b++) {
+            std::copy(jointInstances[boneJoints[b][0]].position, jointInstances[boneJoints[b][0]].position + 3,
+                      boneInstances[b].start);
+            std::copy(jointInstances[boneJoints[b][1]].position, jointInstances[boneJoints[b][1]].position + 3,
+                      boneInstances[b].end);
         }
+        boneRenderer->draw(boneInstances, NUM_BONES, skeletonModel);
 
         drawCoordSystem(&shader, coordVAO, coordEBO, sizeof(coordIndices));
 
         // Draw the skeleton in the correct way
-        if(!realtime) {
-            drawSkeleton(&shader, allInterPos, skeletonFrame % allInterPos.size(), {1.0f, 0.0f, 0.0f});
-        }
-        else {
-            drawSkeletonRealtime(&shader, joints, {1.0f, 0.0f, 0.0f});
-        }
+        skeletonLines->update(joints, glm::vec3(1.0f, 0.0f, 0.0f));
+        skeletonLines->draw(&shader, realtime ? 7.0f : 20.0f);
 
         glfwSwapBuffers(window);
+        frameClock.onSwap(glfwGetTime());
         glfwPollEvents();
 
-        // Time handling: this way, it should move at around 60 FPS
-        if(!realtime) {
-            timerEnd = glfwGetTime();
-            if (timerEnd - timerStart < 1 / (double)60) {
-                sleep(1 - (timerEnd - timerStart));
-                skeletonFrame++;
-            }
-
+        // everything is created by the end of the first frame: from then on the object count must not change
+        if(glObjects < 0) {
+            glObjects = countGLObjects();
         }
 
     }
 
-    glDeleteVertexArrays(1, &gridVAO);
-    glDeleteBuffers(1, &gridVBO);
-    glDeleteBuffers(1, &gridEBO);
+    if(glObjects >= 0 && countGLObjects() != glObjects) {
+        std::cout << "ERROR::GL::OBJECT_LEAK " << countGLObjects() - glObjects << " buffers or vertex arrays"
+                  << std::endl;
+    }
+
+    delete cameraUniforms;
+    delete grid;
+    delete skeletonLines;
     glDeleteVertexArrays(1, &coordVAO);
     glDeleteBuffers(1, &coordVBO);
     glDeleteBuffers(1, &coordEBO);
+    delete jointRenderer;
+    delete boneRenderer;
+
+    if(realtime) {
+        pipeline.printStatistics(std::cout);
+        auto outliers = dynamic_cast<OutlierStage*>(pipeline.findStage("outliers"));
+        if(outliers) {
+            const RejectionMetrics& metrics = outliers->getRejector().getMetrics();
+            std::cout << "Rejected " << metrics.rejectedJoints << " joint samples and " << metrics.rejectedFrames
+                      << " whole frames out of " << metrics.numFrames << " live frames (" << metrics.resets
+                      << " new bodies)" << std::endl;
+        }
+    }
 
     glfwTerminate();
     return 0;
@@ -431,6 +543,12 @@ void mouseCallback(GLFWwindow* window, double posX, double posY) {
     lastX = posX;
     lastY = posY;
 
+    // dragging with the left button scrubs through the clip instead of looking around
+    if(glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS) {
+        playback.scrub(offsetX * SCRUB_SECONDS_PER_PIXEL);
+        return;
+    }
+
     camera.ProcessMouseMovement((float)offsetX, (float)offsetY);
 
 }
@@ -440,6 +558,38 @@ void scrollCallback(GLFWwindow* window, double offsetX, double offsetY) {
 
 }
 
+void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
+
+    if(action != GLFW_PRESS) {
+        return;
+    }
+
+    // playback controls: space pauses, up / down double or halve the speed, R reverses, home / end jump to the ends
+    switch(key) {
+        case GLFW_KEY_SPACE:
+            playback.togglePause();
+            break;
+        case GLFW_KEY_UP:
+            playback.faster();
+            break;
+        case GLFW_KEY_DOWN:
+            playback.slower();
+            break;
+        case GLFW_KEY_R:
+            playback.reverse();
+            break;
+        case GLFW_KEY_HOME:
+            playback.seek(0.0);
+            break;
+        case GLFW_KEY_END:
+            playback.seek(playback.getDuration());
+            break;
+        default:
+            break;
+    }
+
+}
+
 void processInput(GLFWwindow* window) {
 
     if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
@@ -459,4 +609,12 @@ void processInput(GLFWwindow* window) {
         camera.ProcessKeyboard(RIGHT, deltaTime);
     }
 
+    // scrubbing: the arrows move through the clip at twice the normal speed, even when paused
+    if(glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS) {
+        playback.scrub(2 * deltaTime);
+    }
+    if(glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS) {
+        playback.scrub(-2 * deltaTime);
+    }
+
 }